@@ -3,6 +3,8 @@
 #include <carl-arith/core/Common.h>
 #include "BasicConstraint.h"
 #include <carl-arith/interval/Interval.h>
+#include <carl-arith/interval/IntervalSet.h>
+#include <carl-arith/poly/umvpoly/functions/AffineEvaluation.h>
 #include <carl-arith/poly/umvpoly/functions/IntervalEvaluation.h>
 #include <boost/logic/tribool_io.hpp>
 
@@ -13,16 +15,40 @@ inline boost::tribool evaluate(const BasicConstraint<Poly>& c, const Assignment<
 	return evaluate(evaluate(c.lhs(), map), c.relation());
 }
 
+/**
+ * Returns the set of numbers x such that x rel 0 holds.
+ */
+template<typename Number>
+IntervalSet<Number> relation_set(Relation rel) {
+	const Number zero = carl::constant_zero<Number>::get();
+	Interval<Number> negative(zero, BoundType::INFTY, zero, BoundType::STRICT);
+	Interval<Number> positive(zero, BoundType::STRICT, zero, BoundType::INFTY);
+	switch (rel) {
+		case Relation::EQ: return IntervalSet<Number>(Interval<Number>(zero));
+		case Relation::NEQ: return IntervalSet<Number>({ negative, positive });
+		case Relation::LESS: return IntervalSet<Number>(negative);
+		case Relation::LEQ: return IntervalSet<Number>(Interval<Number>(zero, BoundType::INFTY, zero, BoundType::WEAK));
+		case Relation::GREATER: return IntervalSet<Number>(positive);
+		case Relation::GEQ: return IntervalSet<Number>(Interval<Number>(zero, BoundType::WEAK, zero, BoundType::INFTY));
+	}
+	assert(false);
+	return IntervalSet<Number>();
+}
+
 /**
  * Checks whether this constraint is consistent with the given assignment from 
  * the its variables to interval domains.
  * @param _solutionInterval The interval domains of the variables.
+ * @param _stricterRelation This relation is set to a relation R such that this constraint and the given variable bounds
+ *                           imply the constraint formed by R, comparing this constraint's left-hand side to zero.
+ * @param mode How the left-hand side is evaluated over the interval domains.
  * @return 1, if this constraint is consistent with the given intervals;
  *          0, if this constraint is not consistent with the given intervals;
  *          2, if it cannot be decided whether this constraint is consistent with the given intervals.
  */
 template<typename Pol>
-static unsigned consistent_with(const BasicConstraint<Pol>& c, const Assignment<Interval<double>>& _solutionInterval) {
+static unsigned consistent_with(const BasicConstraint<Pol>& c, const Assignment<Interval<double>>& _solutionInterval, Relation& _stricterRelation, IntervalEvaluationMode mode = IntervalEvaluationMode::INTERVAL) {
+	_stricterRelation = c.relation();
 	auto vars = variables(c);
 	if (vars.empty())
 		return carl::evaluate(c.lhs().constant_part(), c.relation()) ? 1 : 0;
@@ -41,70 +67,20 @@ static unsigned consistent_with(const BasicConstraint<Pol>& c, const Assignment<
 		}
 		if (varIter != vars.end())
 			return 2;
-		Interval<double> solutionSpace = carl::evaluate(c.lhs(), _solutionInterval);
+		Interval<double> solutionSpace = carl::evaluate(c.lhs(), _solutionInterval, mode);
 		if (solutionSpace.is_empty())
 			return 2;
-		switch (c.relation()) {
-		case Relation::EQ: {
-			if (solutionSpace.is_zero())
-				return 1;
-			else if (!solutionSpace.contains(0))
-				return 0;
-			break;
-		}
-		case Relation::NEQ: {
-			if (!solutionSpace.contains(0))
-				return 1;
-			break;
-		}
-		case Relation::LESS: {
-			if (solutionSpace.upper_bound_type() != BoundType::INFTY) {
-				if (solutionSpace.upper() < 0)
-					return 1;
-				else if (solutionSpace.upper() == 0 && solutionSpace.upper_bound_type() == BoundType::STRICT)
-					return 1;
-			}
-			if (solutionSpace.lower_bound_type() != BoundType::INFTY && solutionSpace.lower() >= 0)
-				return 0;
-			break;
-		}
-		case Relation::GREATER: {
-			if (solutionSpace.lower_bound_type() != BoundType::INFTY) {
-				if (solutionSpace.lower() > 0)
-					return 1;
-				else if (solutionSpace.lower() == 0 && solutionSpace.lower_bound_type() == BoundType::STRICT)
-					return 1;
-			}
-			if (solutionSpace.upper_bound_type() != BoundType::INFTY && solutionSpace.upper() <= 0)
-				return 0;
-			break;
-		}
-		case Relation::LEQ: {
-			if (solutionSpace.upper_bound_type() != BoundType::INFTY && solutionSpace.upper() <= 0)
-				return 1;
-			if (solutionSpace.lower_bound_type() != BoundType::INFTY) {
-				if (solutionSpace.lower() > 0)
-					return 0;
-				else if (solutionSpace.lower() == 0 && solutionSpace.lower_bound_type() == BoundType::STRICT)
-					return 0;
-			}
-			break;
-		}
-		case Relation::GEQ: {
-			if (solutionSpace.lower_bound_type() != BoundType::INFTY && solutionSpace.lower() >= 0)
-				return 1;
-			if (solutionSpace.upper_bound_type() != BoundType::INFTY) {
-				if (solutionSpace.upper() < 0)
-					return 0;
-				else if (solutionSpace.upper() == 0 && solutionSpace.upper_bound_type() == BoundType::STRICT)
-					return 0;
-			}
-			break;
-		}
-		default: {
-			std::cout << "Error in isConsistent: unexpected relation symbol." << std::endl;
+		IntervalSet<double> satisfying = set_intersection(relation_set<double>(c.relation()), solutionSpace);
+		if (satisfying.empty())
 			return 0;
-		}
+		if (set_is_subset(solutionSpace, satisfying))
+			return 1;
+		// The values of the left-hand side satisfying the constraint may imply a stronger relation.
+		for (Relation rel: { Relation::EQ, Relation::LESS, Relation::GREATER, Relation::LEQ, Relation::GEQ }) {
+			if (set_difference(satisfying, relation_set<double>(rel)).empty()) {
+				_stricterRelation = rel;
+				break;
+			}
 		}
 		return 2;
 	}
@@ -114,119 +90,15 @@ static unsigned consistent_with(const BasicConstraint<Pol>& c, const Assignment<
  * Checks whether this constraint is consistent with the given assignment from 
  * the its variables to interval domains.
  * @param _solutionInterval The interval domains of the variables.
- * @param _stricterRelation This relation is set to a relation R such that this constraint and the given variable bounds
- *                           imply the constraint formed by R, comparing this constraint's left-hand side to zero.
+ * @param mode How the left-hand side is evaluated over the interval domains.
  * @return 1, if this constraint is consistent with the given intervals;
  *          0, if this constraint is not consistent with the given intervals;
  *          2, if it cannot be decided whether this constraint is consistent with the given intervals.
  */
 template<typename Pol>
-static unsigned consistent_with(const BasicConstraint<Pol>& c, const Assignment<Interval<double>>& _solutionInterval, Relation& _stricterRelation) {
-	_stricterRelation = c.relation();
-	auto vars = variables(c);
-	if (vars.empty())
-		return carl::evaluate(c.lhs().constant_part(), c.relation()) ? 1 : 0;
-	else {
-		auto varIter = vars.begin();
-		auto varIntervalIter = _solutionInterval.begin();
-		while (varIter != vars.end() && varIntervalIter != _solutionInterval.end()) {
-			if (*varIter < varIntervalIter->first) {
-				return 2;
-			} else if (*varIter > varIntervalIter->first) {
-				++varIntervalIter;
-			} else {
-				++varIter;
-				++varIntervalIter;
-			}
-		}
-		if (varIter != vars.end())
-			return 2;
-		Interval<double> solutionSpace = carl::evaluate(c.lhs(), _solutionInterval);
-		if (solutionSpace.is_empty())
-			return 2;
-		switch (c.relation()) {
-		case Relation::EQ: {
-			if (solutionSpace.is_zero())
-				return 1;
-			else if (!solutionSpace.contains(0))
-				return 0;
-			break;
-		}
-		case Relation::NEQ: {
-			if (!solutionSpace.contains(0))
-				return 1;
-			if (solutionSpace.upper_bound_type() == BoundType::WEAK && solutionSpace.upper() == 0) {
-				_stricterRelation = Relation::LESS;
-			} else if (solutionSpace.lower_bound_type() == BoundType::WEAK && solutionSpace.lower() == 0) {
-				_stricterRelation = Relation::GREATER;
-			}
-			break;
-		}
-		case Relation::LESS: {
-			if (solutionSpace.upper_bound_type() != BoundType::INFTY) {
-				if (solutionSpace.upper() < 0)
-					return 1;
-				else if (solutionSpace.upper() == 0 && solutionSpace.upper_bound_type() == BoundType::STRICT)
-					return 1;
-			}
-			if (solutionSpace.lower_bound_type() != BoundType::INFTY && solutionSpace.lower() >= 0)
-				return 0;
-			break;
-		}
-		case Relation::GREATER: {
-			if (solutionSpace.lower_bound_type() != BoundType::INFTY) {
-				if (solutionSpace.lower() > 0)
-					return 1;
-				else if (solutionSpace.lower() == 0 && solutionSpace.lower_bound_type() == BoundType::STRICT)
-					return 1;
-			}
-			if (solutionSpace.upper_bound_type() != BoundType::INFTY && solutionSpace.upper() <= 0)
-				return 0;
-			break;
-		}
-		case Relation::LEQ: {
-			if (solutionSpace.upper_bound_type() != BoundType::INFTY) {
-				if (solutionSpace.upper() <= 0) {
-					return 1;
-				}
-			}
-			if (solutionSpace.lower_bound_type() != BoundType::INFTY) {
-				if (solutionSpace.lower() > 0) {
-					return 0;
-				} else if (solutionSpace.lower() == 0) {
-					if (solutionSpace.lower_bound_type() == BoundType::STRICT) {
-						return 0;
-					} else {
-						_stricterRelation = Relation::EQ;
-					}
-				}
-			}
-			break;
-		}
-		case Relation::GEQ: {
-			if (solutionSpace.lower_bound_type() != BoundType::INFTY) {
-				if (solutionSpace.lower() >= 0)
-					return 1;
-			}
-			if (solutionSpace.upper_bound_type() != BoundType::INFTY) {
-				if (solutionSpace.upper() < 0)
-					return 0;
-				else if (solutionSpace.upper() == 0) {
-					if (solutionSpace.upper_bound_type() == BoundType::STRICT)
-						return 0;
-					else
-						_stricterRelation = Relation::EQ;
-				}
-			}
-			break;
-		}
-		default: {
-			std::cout << "Error in isConsistent: unexpected relation symbol." << std::endl;
-			return 0;
-		}
-		}
-		return 2;
-	}
+static unsigned consistent_with(const BasicConstraint<Pol>& c, const Assignment<Interval<double>>& _solutionInterval, IntervalEvaluationMode mode = IntervalEvaluationMode::INTERVAL) {
+	Relation stricterRelation;
+	return consistent_with(c, _solutionInterval, stricterRelation, mode);
 }
 
-}
\ No newline at end of file
+}
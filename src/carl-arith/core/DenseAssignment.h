@@ -0,0 +1,260 @@
+#pragma once
+
+#include "Variable.h"
+
+#include <carl-common/util/streamingOperators.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <map>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace carl {
+
+/**
+ * An assignment of values to variables, stored densely by the variable id.
+ *
+ * Variables created by the VariablePool have consecutive ids, hence a flat vector indexed by the id (and the type, as ids are only unique per type) allows lookups without any pointer chasing.
+ * A bitmap tracks which variables are assigned.
+ * The interface mirrors the relevant part of std::map<Variable, T>, such that DenseAssignment can be used in place of Assignment in evaluation, substitution and interval contraction.
+ * Iteration visits the assigned variables ordered by their id, which is not the order of std::map<Variable, T>.
+ *
+ * Note that the memory consumption is linear in the largest assigned variable id, not in the number of assigned variables.
+ * Variables that only differ in their rank share the same entry.
+ */
+template<typename T>
+class DenseAssignment {
+public:
+	using key_type = Variable;
+	using mapped_type = T;
+	using value_type = std::pair<Variable, T>;
+	using size_type = std::size_t;
+
+private:
+	using Word = std::uint64_t;
+	static constexpr std::size_t WORD_BITS = 64;
+
+	std::vector<value_type> m_entries;
+	std::vector<Word> m_present;
+	std::size_t m_size = 0;
+
+	static std::size_t index(Variable v) {
+		return v.id() * static_cast<std::size_t>(VariableType::TYPE_SIZE) + static_cast<std::size_t>(v.type());
+	}
+	bool present(std::size_t i) const {
+		return i < m_entries.size() && (m_present[i / WORD_BITS] >> (i % WORD_BITS)) & 1;
+	}
+	/// Returns the index of the first assigned entry at or after i, or the number of entries.
+	std::size_t next(std::size_t i) const {
+		std::size_t word = i / WORD_BITS;
+		if (word >= m_present.size()) return m_entries.size();
+		Word bits = m_present[word] & (~Word(0) << (i % WORD_BITS));
+		while (bits == 0) {
+			if (++word == m_present.size()) return m_entries.size();
+			bits = m_present[word];
+		}
+		return word * WORD_BITS + static_cast<std::size_t>(__builtin_ctzll(bits));
+	}
+	/// Makes sure that the entry for v exists and returns its index.
+	std::size_t ensure(Variable v) {
+		assert(v != Variable::NO_VARIABLE);
+		std::size_t i = index(v);
+		if (i >= m_entries.size()) {
+			m_entries.resize(i + 1);
+			m_present.resize(i / WORD_BITS + 1, 0);
+		}
+		return i;
+	}
+	void mark(std::size_t i, Variable v) {
+		m_entries[i].first = v;
+		m_present[i / WORD_BITS] |= Word(1) << (i % WORD_BITS);
+		++m_size;
+	}
+
+	template<bool Const>
+	class Iterator {
+		friend class DenseAssignment;
+		using Container = std::conditional_t<Const, const DenseAssignment, DenseAssignment>;
+		Container* m_assignment = nullptr;
+		std::size_t m_index = 0;
+		Iterator(Container* assignment, std::size_t index): m_assignment(assignment), m_index(index) {}
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = typename DenseAssignment::value_type;
+		using difference_type = std::ptrdiff_t;
+		using pointer = std::conditional_t<Const, const value_type*, value_type*>;
+		using reference = std::conditional_t<Const, const value_type&, value_type&>;
+
+		Iterator() = default;
+		/// Conversion from iterator to const_iterator.
+		template<bool C = Const, std::enable_if_t<C, int> = 0>
+		Iterator(const Iterator<false>& it): m_assignment(it.m_assignment), m_index(it.m_index) {}
+
+		reference operator*() const {
+			return m_assignment->m_entries[m_index];
+		}
+		pointer operator->() const {
+			return &m_assignment->m_entries[m_index];
+		}
+		Iterator& operator++() {
+			m_index = m_assignment->next(m_index + 1);
+			return *this;
+		}
+		Iterator operator++(int) {
+			Iterator res = *this;
+			++(*this);
+			return res;
+		}
+		friend bool operator==(const Iterator& lhs, const Iterator& rhs) {
+			return lhs.m_index == rhs.m_index;
+		}
+		friend bool operator!=(const Iterator& lhs, const Iterator& rhs) {
+			return lhs.m_index != rhs.m_index;
+		}
+	};
+
+public:
+	using iterator = Iterator<false>;
+	using const_iterator = Iterator<true>;
+
+	DenseAssignment() = default;
+	DenseAssignment(std::initializer_list<value_type> init) {
+		for (const auto& e: init) insert(e);
+	}
+	template<typename Comparator>
+	explicit DenseAssignment(const std::map<Variable, T, Comparator>& map) {
+		for (const auto& e: map) emplace(e.first, e.second);
+	}
+
+	/// Converts to an ordinary assignment.
+	std::map<Variable, T> to_map() const {
+		std::map<Variable, T> res;
+		for (const auto& e: *this) res.emplace(e.first, e.second);
+		return res;
+	}
+
+	std::size_t size() const {
+		return m_size;
+	}
+	bool empty() const {
+		return m_size == 0;
+	}
+
+	iterator begin() {
+		return iterator(this, next(0));
+	}
+	iterator end() {
+		return iterator(this, m_entries.size());
+	}
+	const_iterator begin() const {
+		return const_iterator(this, next(0));
+	}
+	const_iterator end() const {
+		return const_iterator(this, m_entries.size());
+	}
+
+	bool contains(Variable v) const {
+		return present(index(v));
+	}
+	std::size_t count(Variable v) const {
+		return contains(v) ? 1 : 0;
+	}
+	iterator find(Variable v) {
+		std::size_t i = index(v);
+		return present(i) ? iterator(this, i) : end();
+	}
+	const_iterator find(Variable v) const {
+		std::size_t i = index(v);
+		return present(i) ? const_iterator(this, i) : end();
+	}
+
+	/**
+	 * Retrieves the value of an assigned variable.
+	 * @throws std::out_of_range if v is not assigned, like std::map::at.
+	 */
+	const T& at(Variable v) const {
+		std::size_t i = index(v);
+		if (!present(i)) throw std::out_of_range("DenseAssignment::at");
+		return m_entries[i].second;
+	}
+	T& at(Variable v) {
+		std::size_t i = index(v);
+		if (!present(i)) throw std::out_of_range("DenseAssignment::at");
+		return m_entries[i].second;
+	}
+	/// Retrieves the value of v, assigning a default constructed value if v is not assigned.
+	T& operator[](Variable v) {
+		std::size_t i = ensure(v);
+		if (!present(i)) {
+			m_entries[i].second = T();
+			mark(i, v);
+		}
+		return m_entries[i].second;
+	}
+
+	template<typename... Args>
+	std::pair<iterator, bool> emplace(Variable v, Args&&... args) {
+		std::size_t i = ensure(v);
+		if (present(i)) return std::make_pair(iterator(this, i), false);
+		m_entries[i].second = T(std::forward<Args>(args)...);
+		mark(i, v);
+		return std::make_pair(iterator(this, i), true);
+	}
+	std::pair<iterator, bool> insert(const value_type& value) {
+		return emplace(value.first, value.second);
+	}
+	template<typename V>
+	std::pair<iterator, bool> insert_or_assign(Variable v, V&& value) {
+		std::size_t i = ensure(v);
+		m_entries[i].second = std::forward<V>(value);
+		if (present(i)) return std::make_pair(iterator(this, i), false);
+		mark(i, v);
+		return std::make_pair(iterator(this, i), true);
+	}
+
+	std::size_t erase(Variable v) {
+		std::size_t i = index(v);
+		if (!present(i)) return 0;
+		m_present[i / WORD_BITS] &= ~(Word(1) << (i % WORD_BITS));
+		m_entries[i].second = T();
+		--m_size;
+		return 1;
+	}
+	/// Removes all assignments, but keeps the allocated memory.
+	void clear() {
+		for (auto& e: *this) e.second = T();
+		std::fill(m_present.begin(), m_present.end(), 0);
+		m_size = 0;
+	}
+
+	friend bool operator==(const DenseAssignment& lhs, const DenseAssignment& rhs) {
+		if (lhs.size() != rhs.size()) return false;
+		for (const auto& e: lhs) {
+			auto it = rhs.find(e.first);
+			if (it == rhs.end() || !(it->second == e.second)) return false;
+		}
+		return true;
+	}
+	friend bool operator!=(const DenseAssignment& lhs, const DenseAssignment& rhs) {
+		return !(lhs == rhs);
+	}
+};
+
+/**
+ * Output a DenseAssignment in the same format as a std::map.
+ * @param os Output stream.
+ * @param a Assignment.
+ * @return os.
+ */
+template<typename T>
+inline std::ostream& operator<<(std::ostream& os, const DenseAssignment<T>& a) {
+	return os << "{" << stream_joined(", ", a, [](auto& o, const auto& p){ o << p.first << " : " << p.second; }) << "}";
+}
+
+}
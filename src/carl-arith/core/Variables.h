@@ -91,6 +91,11 @@ private:
 	mutable std::size_t mAddedSinceCompact = 0;
 	variable_type_filter mFilter;
 
+public:
+	/**
+	 * Sorts the variables and removes duplicates if enough variables were added since the last call, or if forced to and any were added.
+	 * The const accessors compact the container as well, hence a container that is read by multiple threads has to be compacted with force beforehand.
+	 */
 	void compact(bool force = false) const {
 		if ((force && mAddedSinceCompact > 0) || (mAddedSinceCompact > mVariables.size() / 2)) {
 			std::sort(mVariables.begin(), mVariables.end());
@@ -98,7 +103,7 @@ private:
 			mAddedSinceCompact = 0;
 		}
 	}
-public:
+
 	carlVariables(variable_type_filter filter = variable_type_filter::all()) : mFilter(filter) {};
 	explicit carlVariables(std::initializer_list<Variable> i, variable_type_filter filter = variable_type_filter::all()) : mFilter(filter) {
 		add(i);
@@ -0,0 +1,407 @@
+/**
+ * @file IntervalBatch.h
+ *
+ * A batch of intervals of doubles, stored as structure of arrays.
+ *
+ * Interval<double> switches the rounding mode and branches on the bound types for every single operation.
+ * When the same expression is evaluated on many boxes, an IntervalBatch stores all lower and all upper bounds contiguously and every operation processes the whole batch.
+ * The rounding mode is switched to upward rounding once per operation; lower bounds are rounded downwards by negating the operands and the result.
+ * As this code is not compiled with -frounding-math, every rounded operation passes its operands and its result through an optimization barrier.
+ * The kernels use AVX2 or SSE2 if the compiler targets them and fall back to scalar code otherwise.
+ *
+ * All intervals of a batch are closed and nonempty, infinite bounds are represented by infinity.
+ * Strict bounds are relaxed to weak bounds upon conversion, which yields a valid overapproximation.
+ */
+
+#pragma once
+
+#include "Interval.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cfenv>
+#include <cmath>
+#include <limits>
+#include <ostream>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace carl {
+
+namespace detail_interval_batch {
+
+/**
+ * Sets the rounding mode to upward rounding for the lifetime of this object.
+ */
+class UpwardRounding {
+	int m_previous;
+public:
+	UpwardRounding(): m_previous(std::fegetround()) {
+		std::fesetround(FE_UPWARD);
+	}
+	~UpwardRounding() {
+		std::fesetround(m_previous);
+	}
+	UpwardRounding(const UpwardRounding&) = delete;
+	UpwardRounding& operator=(const UpwardRounding&) = delete;
+};
+
+/**
+ * Hides the value from the optimizer.
+ * Without this, the compiler (assuming round-to-nearest) may simplify -((-a) - b) to a + b or (-a) * b to -(a * b),
+ * evaluate operations on constants at compile time, or move operations out of the region where the rounding mode is set.
+ */
+template<typename T>
+inline T opaque(T v) {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	__asm__ __volatile__("" : "+x"(v));
+#else
+	volatile T tmp = v;
+	v = tmp;
+#endif
+	return v;
+}
+
+/// Scalar fallback with the same interface as the SIMD wrappers below.
+struct ScalarOps {
+	using V = double;
+	using M = bool;
+	static constexpr std::size_t width = 1;
+	static V load(const double* p) { return *p; }
+	static void store(double* p, V v) { *p = v; }
+	static V set1(double d) { return d; }
+	static V add(V a, V b) { return a + b; }
+	static V sub(V a, V b) { return a - b; }
+	static V mul(V a, V b) { return a * b; }
+	static V div(V a, V b) { return a / b; }
+	static V neg(V a) { return -a; }
+	static V min(V a, V b) { return a < b ? a : b; }
+	static V max(V a, V b) { return a < b ? b : a; }
+	static M leq(V a, V b) { return a <= b; }
+	static M is_nan(V a) { return std::isnan(a); }
+	static M mask_and(M a, M b) { return a && b; }
+	static V select(M m, V a, V b) { return m ? a : b; }
+};
+
+#if defined(__AVX2__)
+struct SimdOps {
+	using V = __m256d;
+	using M = __m256d;
+	static constexpr std::size_t width = 4;
+	static V load(const double* p) { return _mm256_loadu_pd(p); }
+	static void store(double* p, V v) { _mm256_storeu_pd(p, v); }
+	static V set1(double d) { return _mm256_set1_pd(d); }
+	static V add(V a, V b) { return _mm256_add_pd(a, b); }
+	static V sub(V a, V b) { return _mm256_sub_pd(a, b); }
+	static V mul(V a, V b) { return _mm256_mul_pd(a, b); }
+	static V div(V a, V b) { return _mm256_div_pd(a, b); }
+	static V neg(V a) { return _mm256_xor_pd(a, _mm256_set1_pd(-0.0)); }
+	static V min(V a, V b) { return _mm256_min_pd(a, b); }
+	static V max(V a, V b) { return _mm256_max_pd(a, b); }
+	static M leq(V a, V b) { return _mm256_cmp_pd(a, b, _CMP_LE_OQ); }
+	static M is_nan(V a) { return _mm256_cmp_pd(a, a, _CMP_UNORD_Q); }
+	static M mask_and(M a, M b) { return _mm256_and_pd(a, b); }
+	static V select(M m, V a, V b) { return _mm256_blendv_pd(b, a, m); }
+};
+#elif defined(__SSE2__)
+struct SimdOps {
+	using V = __m128d;
+	using M = __m128d;
+	static constexpr std::size_t width = 2;
+	static V load(const double* p) { return _mm_loadu_pd(p); }
+	static void store(double* p, V v) { _mm_storeu_pd(p, v); }
+	static V set1(double d) { return _mm_set1_pd(d); }
+	static V add(V a, V b) { return _mm_add_pd(a, b); }
+	static V sub(V a, V b) { return _mm_sub_pd(a, b); }
+	static V mul(V a, V b) { return _mm_mul_pd(a, b); }
+	static V div(V a, V b) { return _mm_div_pd(a, b); }
+	static V neg(V a) { return _mm_xor_pd(a, _mm_set1_pd(-0.0)); }
+	static V min(V a, V b) { return _mm_min_pd(a, b); }
+	static V max(V a, V b) { return _mm_max_pd(a, b); }
+	static M leq(V a, V b) { return _mm_cmple_pd(a, b); }
+	static M is_nan(V a) { return _mm_cmpunord_pd(a, a); }
+	static M mask_and(M a, M b) { return _mm_and_pd(a, b); }
+	static V select(M m, V a, V b) { return _mm_or_pd(_mm_and_pd(m, a), _mm_andnot_pd(m, b)); }
+};
+#else
+using SimdOps = ScalarOps;
+#endif
+
+/*
+ * Kernels, assuming upward rounding. They compute the result for width intervals at once.
+ * Products of zero and infinity yield NaN, which is replaced by zero.
+ */
+template<typename Ops>
+struct Kernels {
+	using V = typename Ops::V;
+
+	/// a + b rounded upwards.
+	static V add_up(V a, V b) { return opaque(Ops::add(opaque(a), opaque(b))); }
+	/// a - b rounded upwards.
+	static V sub_up(V a, V b) { return opaque(Ops::sub(opaque(a), opaque(b))); }
+	/// a * b rounded upwards.
+	static V mul_up(V a, V b) { return opaque(Ops::mul(opaque(a), opaque(b))); }
+	/// a / b rounded upwards.
+	static V div_up(V a, V b) { return opaque(Ops::div(opaque(a), opaque(b))); }
+	/// a + b rounded downwards.
+	static V add_down(V a, V b) { return Ops::neg(opaque(Ops::sub(opaque(Ops::neg(a)), opaque(b)))); }
+	/// a - b rounded downwards.
+	static V sub_down(V a, V b) { return Ops::neg(opaque(Ops::sub(opaque(b), opaque(a)))); }
+	/// a * b rounded downwards.
+	static V mul_down(V a, V b) { return Ops::neg(opaque(Ops::mul(opaque(Ops::neg(a)), opaque(b)))); }
+	/// a / b rounded downwards.
+	static V div_down(V a, V b) { return Ops::neg(opaque(Ops::div(opaque(Ops::neg(a)), opaque(b)))); }
+	static V no_nan(V a) { return Ops::select(Ops::is_nan(a), Ops::set1(0), a); }
+
+	static void add(V al, V au, V bl, V bu, V& rl, V& ru) {
+		rl = add_down(al, bl);
+		ru = add_up(au, bu);
+	}
+	static void sub(V al, V au, V bl, V bu, V& rl, V& ru) {
+		rl = sub_down(al, bu);
+		ru = sub_up(au, bl);
+	}
+	static void mul(V al, V au, V bl, V bu, V& rl, V& ru) {
+		rl = Ops::min(
+			Ops::min(no_nan(mul_down(al, bl)), no_nan(mul_down(al, bu))),
+			Ops::min(no_nan(mul_down(au, bl)), no_nan(mul_down(au, bu)))
+		);
+		ru = Ops::max(
+			Ops::max(no_nan(mul_up(al, bl)), no_nan(mul_up(al, bu))),
+			Ops::max(no_nan(mul_up(au, bl)), no_nan(mul_up(au, bu)))
+		);
+	}
+	static void div(V al, V au, V bl, V bu, V& rl, V& ru) {
+		V l = Ops::min(
+			Ops::min(no_nan(div_down(al, bl)), no_nan(div_down(al, bu))),
+			Ops::min(no_nan(div_down(au, bl)), no_nan(div_down(au, bu)))
+		);
+		V u = Ops::max(
+			Ops::max(no_nan(div_up(al, bl)), no_nan(div_up(al, bu))),
+			Ops::max(no_nan(div_up(au, bl)), no_nan(div_up(au, bu)))
+		);
+		// If the divisor contains zero, the result is unbounded.
+		auto zero = Ops::set1(0);
+		auto contains_zero = Ops::mask_and(Ops::leq(bl, zero), Ops::leq(zero, bu));
+		rl = Ops::select(contains_zero, Ops::set1(-std::numeric_limits<double>::infinity()), l);
+		ru = Ops::select(contains_zero, Ops::set1(std::numeric_limits<double>::infinity()), u);
+	}
+	/// Power of the nonnegative a, rounded downwards (d) and upwards (u).
+	static void pow_nonneg(V a, unsigned e, V& d, V& u) {
+		d = a;
+		u = a;
+		for (unsigned i = 1; i < e; ++i) {
+			d = mul_down(d, a);
+			u = mul_up(u, a);
+		}
+	}
+	static void pow(V al, V au, unsigned e, V& rl, V& ru) {
+		auto zero = Ops::set1(0);
+		auto lower_nonneg = Ops::leq(zero, al);
+		auto upper_nonpos = Ops::leq(au, zero);
+		V lmag = Ops::max(al, Ops::neg(al));
+		V umag = Ops::max(au, Ops::neg(au));
+		V ld, lu, ud, uu;
+		pow_nonneg(lmag, e, ld, lu);
+		pow_nonneg(umag, e, ud, uu);
+		if (e % 2 == 1) {
+			rl = Ops::select(lower_nonneg, ld, Ops::neg(lu));
+			ru = Ops::select(upper_nonpos, Ops::neg(ud), uu);
+		} else {
+			rl = Ops::select(lower_nonneg, ld, Ops::select(upper_nonpos, ud, zero));
+			ru = Ops::select(lower_nonneg, uu, Ops::select(upper_nonpos, lu, Ops::max(lu, uu)));
+		}
+	}
+};
+
+/**
+ * Applies the binary kernel to all intervals, first with the SIMD kernel and then with the scalar kernel for the remainder.
+ */
+template<typename SimdKernel, typename ScalarKernel>
+void apply(std::size_t size, const double* al, const double* au, const double* bl, const double* bu, double* rl, double* ru, SimdKernel&& simd, ScalarKernel&& scalar) {
+	UpwardRounding rounding;
+	std::size_t i = 0;
+	for (; i + SimdOps::width <= size; i += SimdOps::width) {
+		typename SimdOps::V l, u;
+		simd(SimdOps::load(al + i), SimdOps::load(au + i), SimdOps::load(bl + i), SimdOps::load(bu + i), l, u);
+		SimdOps::store(rl + i, l);
+		SimdOps::store(ru + i, u);
+	}
+	for (; i < size; ++i) {
+		scalar(al[i], au[i], bl[i], bu[i], rl[i], ru[i]);
+	}
+}
+
+}
+
+template<typename Number>
+class IntervalBatch;
+
+/**
+ * A batch of closed intervals of doubles, stored as structure of arrays.
+ * See IntervalBatch.h for details.
+ */
+template<>
+class IntervalBatch<double> {
+	std::vector<double> m_lower;
+	std::vector<double> m_upper;
+
+	static double to_lower(const Interval<double>& i) {
+		assert(!i.is_empty());
+		if (i.lower_bound_type() == BoundType::INFTY) return -std::numeric_limits<double>::infinity();
+		return i.lower();
+	}
+	static double to_upper(const Interval<double>& i) {
+		assert(!i.is_empty());
+		if (i.upper_bound_type() == BoundType::INFTY) return std::numeric_limits<double>::infinity();
+		return i.upper();
+	}
+public:
+	IntervalBatch() = default;
+
+	/// Creates a batch of the given size, where all intervals are equal to i.
+	explicit IntervalBatch(std::size_t size, const Interval<double>& i = Interval<double>(0)):
+		m_lower(size, to_lower(i)), m_upper(size, to_upper(i))
+	{}
+
+	explicit IntervalBatch(const std::vector<Interval<double>>& intervals) {
+		m_lower.reserve(intervals.size());
+		m_upper.reserve(intervals.size());
+		for (const auto& i: intervals) {
+			m_lower.push_back(to_lower(i));
+			m_upper.push_back(to_upper(i));
+		}
+	}
+
+	std::size_t size() const {
+		return m_lower.size();
+	}
+	void resize(std::size_t size) {
+		m_lower.resize(size);
+		m_upper.resize(size);
+	}
+
+	/// Sets all intervals to i.
+	void fill(const Interval<double>& i) {
+		std::fill(m_lower.begin(), m_lower.end(), to_lower(i));
+		std::fill(m_upper.begin(), m_upper.end(), to_upper(i));
+	}
+	void set(std::size_t n, const Interval<double>& i) {
+		assert(n < size());
+		m_lower[n] = to_lower(i);
+		m_upper[n] = to_upper(i);
+	}
+	Interval<double> get(std::size_t n) const {
+		assert(n < size());
+		BoundType lbt = std::isinf(m_lower[n]) ? BoundType::INFTY : BoundType::WEAK;
+		BoundType ubt = std::isinf(m_upper[n]) ? BoundType::INFTY : BoundType::WEAK;
+		return Interval<double>(lbt == BoundType::INFTY ? 0.0 : m_lower[n], lbt, ubt == BoundType::INFTY ? 0.0 : m_upper[n], ubt);
+	}
+	Interval<double> operator[](std::size_t n) const {
+		return get(n);
+	}
+
+	const double* lower() const { return m_lower.data(); }
+	const double* upper() const { return m_upper.data(); }
+	double* lower() { return m_lower.data(); }
+	double* upper() { return m_upper.data(); }
+};
+
+/**
+ * Computes res = a + b. res may be one of the arguments.
+ */
+inline void add(const IntervalBatch<double>& a, const IntervalBatch<double>& b, IntervalBatch<double>& res) {
+	using namespace detail_interval_batch;
+	assert(a.size() == b.size());
+	res.resize(a.size());
+	apply(a.size(), a.lower(), a.upper(), b.lower(), b.upper(), res.lower(), res.upper(), Kernels<SimdOps>::add, Kernels<ScalarOps>::add);
+}
+
+/**
+ * Computes res = a - b. res may be one of the arguments.
+ */
+inline void sub(const IntervalBatch<double>& a, const IntervalBatch<double>& b, IntervalBatch<double>& res) {
+	using namespace detail_interval_batch;
+	assert(a.size() == b.size());
+	res.resize(a.size());
+	apply(a.size(), a.lower(), a.upper(), b.lower(), b.upper(), res.lower(), res.upper(), Kernels<SimdOps>::sub, Kernels<ScalarOps>::sub);
+}
+
+/**
+ * Computes res = a * b. res may be one of the arguments.
+ */
+inline void mul(const IntervalBatch<double>& a, const IntervalBatch<double>& b, IntervalBatch<double>& res) {
+	using namespace detail_interval_batch;
+	assert(a.size() == b.size());
+	res.resize(a.size());
+	apply(a.size(), a.lower(), a.upper(), b.lower(), b.upper(), res.lower(), res.upper(), Kernels<SimdOps>::mul, Kernels<ScalarOps>::mul);
+}
+
+/**
+ * Computes res = a / b. If b contains zero, the result is the whole real line. res may be one of the arguments.
+ */
+inline void div(const IntervalBatch<double>& a, const IntervalBatch<double>& b, IntervalBatch<double>& res) {
+	using namespace detail_interval_batch;
+	assert(a.size() == b.size());
+	res.resize(a.size());
+	apply(a.size(), a.lower(), a.upper(), b.lower(), b.upper(), res.lower(), res.upper(), Kernels<SimdOps>::div, Kernels<ScalarOps>::div);
+}
+
+/**
+ * Computes res = a^exp. res may be the argument.
+ */
+inline void pow(const IntervalBatch<double>& a, unsigned exp, IntervalBatch<double>& res) {
+	using namespace detail_interval_batch;
+	res.resize(a.size());
+	if (exp == 0) {
+		res.fill(Interval<double>(1));
+		return;
+	}
+	// The second operand is ignored.
+	apply(a.size(), a.lower(), a.upper(), a.lower(), a.upper(), res.lower(), res.upper(),
+		[exp](auto al, auto au, auto, auto, auto& rl, auto& ru) { Kernels<SimdOps>::pow(al, au, exp, rl, ru); },
+		[exp](auto al, auto au, auto, auto, auto& rl, auto& ru) { Kernels<ScalarOps>::pow(al, au, exp, rl, ru); }
+	);
+}
+
+/**
+ * Computes res = a^2. res may be the argument.
+ */
+inline void sqr(const IntervalBatch<double>& a, IntervalBatch<double>& res) {
+	pow(a, 2, res);
+}
+
+inline IntervalBatch<double> operator+(const IntervalBatch<double>& a, const IntervalBatch<double>& b) {
+	IntervalBatch<double> res;
+	add(a, b, res);
+	return res;
+}
+inline IntervalBatch<double> operator-(const IntervalBatch<double>& a, const IntervalBatch<double>& b) {
+	IntervalBatch<double> res;
+	sub(a, b, res);
+	return res;
+}
+inline IntervalBatch<double> operator*(const IntervalBatch<double>& a, const IntervalBatch<double>& b) {
+	IntervalBatch<double> res;
+	mul(a, b, res);
+	return res;
+}
+inline IntervalBatch<double> operator/(const IntervalBatch<double>& a, const IntervalBatch<double>& b) {
+	IntervalBatch<double> res;
+	div(a, b, res);
+	return res;
+}
+
+inline std::ostream& operator<<(std::ostream& os, const IntervalBatch<double>& b) {
+	os << "[";
+	for (std::size_t i = 0; i < b.size(); ++i) {
+		if (i > 0) os << ", ";
+		os << b[i];
+	}
+	return os << "]";
+}
+
+}
@@ -0,0 +1,229 @@
+/**
+ * @file IntervalSet.h
+ *
+ * Finite unions of intervals.
+ */
+
+#pragma once
+
+#include "Interval.h"
+#include "operators.h"
+#include "set_theory.h"
+
+#include <carl-common/util/streamingOperators.h>
+
+#include <boost/container/small_vector.hpp>
+
+#include <initializer_list>
+#include <ostream>
+
+namespace carl {
+
+/**
+ * A finite union of intervals.
+ *
+ * The intervals are kept normalized: they are nonempty, sorted and neither overlap nor connect (like [0,1) and [1,2]).
+ * Hence two sets are equal if and only if their intervals are equal, and union, intersection and complement are computed by a single merge in linear time.
+ * Up to two intervals are stored inline, which covers the results of division and even roots without any allocation.
+ */
+template<typename Number>
+class IntervalSet {
+public:
+	using Storage = boost::container::small_vector<Interval<Number>, 2>;
+	using const_iterator = typename Storage::const_iterator;
+private:
+	Storage mIntervals;
+
+	/// Checks whether an interval starting at lower can be merged into an interval ending at upper.
+	static bool mergeable(const UpperBound<Number>& upper, const LowerBound<Number>& lower) {
+		return !(upper < lower) || bounds_connect(upper, lower);
+	}
+	/// Appends an interval that does not start before the last interval.
+	void append(const Interval<Number>& i) {
+		if (i.is_empty()) return;
+		if (!mIntervals.empty() && mergeable(mIntervals.back().upper_bound(), i.lower_bound())) {
+			if (mIntervals.back().upper_bound() < i.upper_bound()) {
+				mIntervals.back() = Interval<Number>(mIntervals.back().lower_bound(), i.upper_bound());
+			}
+			return;
+		}
+		mIntervals.push_back(i);
+	}
+
+public:
+	/// Creates the empty set.
+	IntervalSet() = default;
+	explicit IntervalSet(const Interval<Number>& i) {
+		append(i);
+	}
+	IntervalSet(std::initializer_list<Interval<Number>> intervals) {
+		for (const auto& i: intervals) insert(i);
+	}
+
+	static IntervalSet unbounded() {
+		return IntervalSet(Interval<Number>::unbounded_interval());
+	}
+
+	std::size_t size() const {
+		return mIntervals.size();
+	}
+	bool empty() const {
+		return mIntervals.empty();
+	}
+	const_iterator begin() const {
+		return mIntervals.begin();
+	}
+	const_iterator end() const {
+		return mIntervals.end();
+	}
+	const Interval<Number>& operator[](std::size_t i) const {
+		assert(i < mIntervals.size());
+		return mIntervals[i];
+	}
+	void clear() {
+		mIntervals.clear();
+	}
+
+	/**
+	 * Adds an interval to the set.
+	 */
+	void insert(const Interval<Number>& i) {
+		if (i.is_empty()) return;
+		if (mIntervals.empty() || mIntervals.back().lower_bound() < i.lower_bound()) {
+			append(i);
+			return;
+		}
+		Storage old;
+		old.swap(mIntervals);
+		bool inserted = false;
+		for (const auto& cur: old) {
+			if (!inserted && i.lower_bound() < cur.lower_bound()) {
+				append(i);
+				inserted = true;
+			}
+			append(cur);
+		}
+		if (!inserted) append(i);
+	}
+
+	bool contains(const Number& n) const {
+		for (const auto& i: mIntervals) {
+			if (i.contains(n)) return true;
+		}
+		return false;
+	}
+
+	/// The smallest interval containing the whole set.
+	Interval<Number> convex_hull() const {
+		if (mIntervals.empty()) return Interval<Number>::empty_interval();
+		return Interval<Number>(mIntervals.front().lower_bound(), mIntervals.back().upper_bound());
+	}
+
+	/**
+	 * Overapproximates the set by at most two intervals, split at the largest gap.
+	 * @param resA The first interval, empty if the set is empty.
+	 * @param resB The second interval, empty if the result is not twofold.
+	 * @return True, if the result is twofold.
+	 */
+	bool split_at_largest_gap(Interval<Number>& resA, Interval<Number>& resB) const {
+		if (mIntervals.size() <= 1) {
+			resA = mIntervals.empty() ? Interval<Number>::empty_interval() : mIntervals.front();
+			resB = Interval<Number>::empty_interval();
+			return false;
+		}
+		std::size_t gap = 0;
+		Number bestDistance = mIntervals[1].lower() - mIntervals[0].upper();
+		for (std::size_t i = 1; i + 1 < mIntervals.size(); ++i) {
+			Number distance = mIntervals[i + 1].lower() - mIntervals[i].upper();
+			if (bestDistance < distance) {
+				bestDistance = distance;
+				gap = i;
+			}
+		}
+		resA = Interval<Number>(mIntervals.front().lower_bound(), mIntervals[gap].upper_bound());
+		resB = Interval<Number>(mIntervals[gap + 1].lower_bound(), mIntervals.back().upper_bound());
+		return true;
+	}
+
+	friend bool operator==(const IntervalSet& lhs, const IntervalSet& rhs) {
+		return lhs.mIntervals == rhs.mIntervals;
+	}
+	friend bool operator!=(const IntervalSet& lhs, const IntervalSet& rhs) {
+		return !(lhs == rhs);
+	}
+
+	friend IntervalSet set_union(const IntervalSet& lhs, const IntervalSet& rhs) {
+		IntervalSet res;
+		auto l = lhs.begin();
+		auto r = rhs.begin();
+		while (l != lhs.end() || r != rhs.end()) {
+			if (r == rhs.end() || (l != lhs.end() && !(r->lower_bound() < l->lower_bound()))) {
+				res.append(*l++);
+			} else {
+				res.append(*r++);
+			}
+		}
+		return res;
+	}
+
+	friend IntervalSet set_intersection(const IntervalSet& lhs, const IntervalSet& rhs) {
+		IntervalSet res;
+		auto l = lhs.begin();
+		auto r = rhs.begin();
+		while (l != lhs.end() && r != rhs.end()) {
+			auto i = set_intersection(*l, *r);
+			if (!i.is_empty()) res.mIntervals.push_back(std::move(i));
+			if (l->upper_bound() < r->upper_bound()) ++l;
+			else ++r;
+		}
+		return res;
+	}
+
+	friend IntervalSet set_complement(const IntervalSet& set) {
+		IntervalSet res;
+		if (set.empty()) return unbounded();
+		const auto& front = set.mIntervals.front();
+		if (front.lower_bound_type() != BoundType::INFTY) {
+			res.mIntervals.emplace_back(front.lower(), BoundType::INFTY, front.lower(), get_other_bound_type(front.lower_bound_type()));
+		}
+		for (std::size_t i = 0; i + 1 < set.size(); ++i) {
+			const auto& cur = set.mIntervals[i];
+			const auto& next = set.mIntervals[i + 1];
+			res.mIntervals.emplace_back(cur.upper(), get_other_bound_type(cur.upper_bound_type()), next.lower(), get_other_bound_type(next.lower_bound_type()));
+		}
+		const auto& back = set.mIntervals.back();
+		if (back.upper_bound_type() != BoundType::INFTY) {
+			res.mIntervals.emplace_back(back.upper(), get_other_bound_type(back.upper_bound_type()), back.upper(), BoundType::INFTY);
+		}
+		return res;
+	}
+
+	friend IntervalSet set_difference(const IntervalSet& lhs, const IntervalSet& rhs) {
+		return set_intersection(lhs, set_complement(rhs));
+	}
+};
+
+template<typename Number>
+IntervalSet<Number> set_intersection(const IntervalSet<Number>& lhs, const Interval<Number>& rhs) {
+	return set_intersection(lhs, IntervalSet<Number>(rhs));
+}
+
+/**
+ * Checks whether the interval is a subset of the set.
+ */
+template<typename Number>
+bool set_is_subset(const Interval<Number>& lhs, const IntervalSet<Number>& rhs) {
+	if (lhs.is_empty()) return true;
+	for (const auto& i: rhs) {
+		if (set_is_subset(lhs, i)) return true;
+	}
+	return false;
+}
+
+template<typename Number>
+std::ostream& operator<<(std::ostream& os, const IntervalSet<Number>& set) {
+	if (set.empty()) return os << "{}";
+	return os << stream_joined(" u ", set);
+}
+
+}
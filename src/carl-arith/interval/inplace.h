@@ -0,0 +1,455 @@
+/**
+ * @file inplace.h
+ *
+ * Interval arithmetic that stores the result in an existing interval.
+ *
+ * The operators in operators.h return fresh intervals. For Interval<mpq_class>, this allocates two new rationals per operation,
+ * which dominates exact interval evaluation. The functions in this file take the result as last argument (like the kernels in IntervalBatch.h)
+ * and, for mpq_class, compute the bounds with mpq_add, mpq_mul etc. into a thread local scratch set that is swapped with the bounds of the result.
+ * Hence, once the result and the scratch set have grown large enough, no operation allocates.
+ * For other number types, the functions fall back to the operators.
+ * Division by an interval, extended division, abs and sqrt always use the operators for intervals containing zero or irrational results.
+ *
+ * Every operation also has an `_assign` variant that takes the result as first operand, e.g. `add_assign(res, b)` sets res to res + b.
+ * The result may alias any of the operands.
+ * Unbounded operands are rare in exact evaluation and also handled by the operators.
+ */
+
+#pragma once
+
+#include "Interval.h"
+#include "power.h"
+
+#include <gmpxx.h>
+
+namespace carl {
+
+namespace detail_inplace {
+
+/// The scratch set used by all operations of a thread.
+struct Scratch {
+	mpq_class lower;
+	mpq_class upper;
+	mpq_class tmp;
+};
+
+inline Scratch& scratch() {
+	static thread_local Scratch s;
+	return s;
+}
+
+/// boost::numeric::interval only provides const access to its bounds.
+inline mpq_class& lower(Interval<mpq_class>& i) {
+	return const_cast<mpq_class&>(i.content().lower());
+}
+inline mpq_class& upper(Interval<mpq_class>& i) {
+	return const_cast<mpq_class&>(i.content().upper());
+}
+
+inline bool is_bounded(const Interval<mpq_class>& i) {
+	return i.lower_bound_type() != BoundType::INFTY && i.upper_bound_type() != BoundType::INFTY;
+}
+
+inline void set_empty(Interval<mpq_class>& res) {
+	mpq_set_ui(lower(res).get_mpq_t(), 0, 1);
+	mpq_set_ui(upper(res).get_mpq_t(), 0, 1);
+	res.set_lower_bound_type(BoundType::STRICT);
+	res.set_upper_bound_type(BoundType::STRICT);
+}
+
+/// Moves the bounds from the scratch set to res. Bound types must not be INFTY.
+inline void store(Scratch& s, BoundType lowerType, BoundType upperType, Interval<mpq_class>& res) {
+	assert(lowerType != BoundType::INFTY && upperType != BoundType::INFTY);
+	assert(s.lower <= s.upper);
+	mpq_swap(lower(res).get_mpq_t(), s.lower.get_mpq_t());
+	mpq_swap(upper(res).get_mpq_t(), s.upper.get_mpq_t());
+	res.set_lower_bound_type(lowerType);
+	res.set_upper_bound_type(upperType);
+}
+
+/// Sets r to x^e.
+inline void pow(mpq_ptr r, mpq_srcptr x, unsigned long e) {
+	mpz_pow_ui(mpq_numref(r), mpq_numref(x), e);
+	mpz_pow_ui(mpq_denref(r), mpq_denref(x), e);
+}
+
+}
+
+/**
+ * Sets res to the point interval n.
+ */
+template<typename Number>
+inline void assign(const Number& n, Interval<Number>& res) {
+	res = Interval<Number>(n);
+}
+inline void assign(const mpq_class& n, Interval<mpq_class>& res) {
+	detail_inplace::lower(res) = n;
+	detail_inplace::upper(res) = n;
+	res.set_lower_bound_type(BoundType::WEAK);
+	res.set_upper_bound_type(BoundType::WEAK);
+}
+
+/**
+ * Sets res to a + b.
+ */
+template<typename Number>
+inline void add(const Interval<Number>& a, const Interval<Number>& b, Interval<Number>& res) {
+	res = a.add(b);
+}
+inline void add(const Interval<mpq_class>& a, const Interval<mpq_class>& b, Interval<mpq_class>& res) {
+	// Like Interval::add(), only an empty b yields the empty interval.
+	if (b.is_empty()) return detail_inplace::set_empty(res);
+	if (!detail_inplace::is_bounded(a) || !detail_inplace::is_bounded(b)) {
+		res = a.add(b);
+		return;
+	}
+	auto& s = detail_inplace::scratch();
+	mpq_add(s.lower.get_mpq_t(), a.lower().get_mpq_t(), b.lower().get_mpq_t());
+	mpq_add(s.upper.get_mpq_t(), a.upper().get_mpq_t(), b.upper().get_mpq_t());
+	detail_inplace::store(s, get_strictest_bound_type(a.lower_bound_type(), b.lower_bound_type()), get_strictest_bound_type(a.upper_bound_type(), b.upper_bound_type()), res);
+}
+
+/**
+ * Sets res to a + n.
+ */
+template<typename Number>
+inline void add(const Interval<Number>& a, const Number& n, Interval<Number>& res) {
+	res = a + n;
+}
+inline void add(const Interval<mpq_class>& a, const mpq_class& n, Interval<mpq_class>& res) {
+	if (!detail_inplace::is_bounded(a)) {
+		res = a + n;
+		return;
+	}
+	auto& s = detail_inplace::scratch();
+	mpq_add(s.lower.get_mpq_t(), a.lower().get_mpq_t(), n.get_mpq_t());
+	mpq_add(s.upper.get_mpq_t(), a.upper().get_mpq_t(), n.get_mpq_t());
+	detail_inplace::store(s, a.lower_bound_type(), a.upper_bound_type(), res);
+}
+
+/**
+ * Sets res to -a.
+ */
+template<typename Number>
+inline void neg(const Interval<Number>& a, Interval<Number>& res) {
+	res = a.inverse();
+}
+inline void neg(const Interval<mpq_class>& a, Interval<mpq_class>& res) {
+	if (!detail_inplace::is_bounded(a)) {
+		res = a.inverse();
+		return;
+	}
+	auto& s = detail_inplace::scratch();
+	mpq_neg(s.lower.get_mpq_t(), a.upper().get_mpq_t());
+	mpq_neg(s.upper.get_mpq_t(), a.lower().get_mpq_t());
+	detail_inplace::store(s, a.upper_bound_type(), a.lower_bound_type(), res);
+}
+
+/**
+ * Sets res to a - b.
+ */
+template<typename Number>
+inline void sub(const Interval<Number>& a, const Interval<Number>& b, Interval<Number>& res) {
+	res = a.sub(b);
+}
+inline void sub(const Interval<mpq_class>& a, const Interval<mpq_class>& b, Interval<mpq_class>& res) {
+	if (b.is_empty()) return detail_inplace::set_empty(res);
+	if (!detail_inplace::is_bounded(a) || !detail_inplace::is_bounded(b)) {
+		res = a.sub(b);
+		return;
+	}
+	auto& s = detail_inplace::scratch();
+	mpq_sub(s.lower.get_mpq_t(), a.lower().get_mpq_t(), b.upper().get_mpq_t());
+	mpq_sub(s.upper.get_mpq_t(), a.upper().get_mpq_t(), b.lower().get_mpq_t());
+	detail_inplace::store(s, get_strictest_bound_type(a.lower_bound_type(), b.upper_bound_type()), get_strictest_bound_type(a.upper_bound_type(), b.lower_bound_type()), res);
+}
+
+/**
+ * Sets res to a * n.
+ */
+template<typename Number>
+inline void mul(const Interval<Number>& a, const Number& n, Interval<Number>& res) {
+	res = a * n;
+}
+inline void mul(const Interval<mpq_class>& a, const mpq_class& n, Interval<mpq_class>& res) {
+	if (carl::is_zero(n) && !a.is_empty()) return assign(n, res);
+	if (!detail_inplace::is_bounded(a)) {
+		res = a * n;
+		return;
+	}
+	auto& s = detail_inplace::scratch();
+	BoundType lowerType = a.lower_bound_type();
+	BoundType upperType = a.upper_bound_type();
+	if (n > 0) {
+		mpq_mul(s.lower.get_mpq_t(), a.lower().get_mpq_t(), n.get_mpq_t());
+		mpq_mul(s.upper.get_mpq_t(), a.upper().get_mpq_t(), n.get_mpq_t());
+	} else {
+		mpq_mul(s.lower.get_mpq_t(), a.upper().get_mpq_t(), n.get_mpq_t());
+		mpq_mul(s.upper.get_mpq_t(), a.lower().get_mpq_t(), n.get_mpq_t());
+		std::swap(lowerType, upperType);
+	}
+	detail_inplace::store(s, lowerType, upperType, res);
+}
+
+/**
+ * Sets res to a * b.
+ */
+template<typename Number>
+inline void mul(const Interval<Number>& a, const Interval<Number>& b, Interval<Number>& res) {
+	res = a.mul(b);
+}
+inline void mul(const Interval<mpq_class>& a, const Interval<mpq_class>& b, Interval<mpq_class>& res) {
+	if (a.is_empty() || b.is_empty()) return detail_inplace::set_empty(res);
+	if (!detail_inplace::is_bounded(a) || !detail_inplace::is_bounded(b)) {
+		res = a.mul(b);
+		return;
+	}
+	auto& s = detail_inplace::scratch();
+	// Classifies an interval as containing negative and positive numbers (M), only nonpositive (N), only nonnegative (P) or only zero (Z).
+	enum Class { M, N, P, Z };
+	auto classify = [](const Interval<mpq_class>& i) {
+		if (mpq_sgn(i.lower().get_mpq_t()) < 0) return mpq_sgn(i.upper().get_mpq_t()) > 0 ? M : N;
+		return mpq_sgn(i.upper().get_mpq_t()) > 0 ? P : Z;
+	};
+	mpq_srcptr xl = a.lower().get_mpq_t();
+	mpq_srcptr xu = a.upper().get_mpq_t();
+	mpq_srcptr yl = b.lower().get_mpq_t();
+	mpq_srcptr yu = b.upper().get_mpq_t();
+	BoundType xlt = a.lower_bound_type();
+	BoundType xut = a.upper_bound_type();
+	BoundType ylt = b.lower_bound_type();
+	BoundType yut = b.upper_bound_type();
+	BoundType lowerType = BoundType::WEAK;
+	BoundType upperType = BoundType::WEAK;
+	auto set = [&s, &lowerType, &upperType](mpq_srcptr l1, mpq_srcptr l2, BoundType lt, mpq_srcptr u1, mpq_srcptr u2, BoundType ut) {
+		mpq_mul(s.lower.get_mpq_t(), l1, l2);
+		mpq_mul(s.upper.get_mpq_t(), u1, u2);
+		lowerType = lt;
+		upperType = ut;
+	};
+	auto set_zero = [&s, &lowerType, &upperType](BoundType lt, BoundType ut) {
+		mpq_set_ui(s.lower.get_mpq_t(), 0, 1);
+		mpq_set_ui(s.upper.get_mpq_t(), 0, 1);
+		lowerType = lt;
+		upperType = ut;
+	};
+	// The case distinction follows Interval::mul().
+	switch (classify(a)) {
+		case M:
+			switch (classify(b)) {
+				case M:
+					mpq_mul(s.lower.get_mpq_t(), xl, yu);
+					mpq_mul(s.tmp.get_mpq_t(), xu, yl);
+					if (s.lower > s.tmp) {
+						mpq_swap(s.lower.get_mpq_t(), s.tmp.get_mpq_t());
+						lowerType = get_strictest_bound_type(xut, ylt);
+					} else {
+						lowerType = get_strictest_bound_type(xlt, yut);
+					}
+					mpq_mul(s.upper.get_mpq_t(), xl, yl);
+					mpq_mul(s.tmp.get_mpq_t(), xu, yu);
+					if (s.upper < s.tmp) {
+						mpq_swap(s.upper.get_mpq_t(), s.tmp.get_mpq_t());
+						upperType = get_strictest_bound_type(xut, yut);
+					} else {
+						upperType = get_strictest_bound_type(xlt, ylt);
+					}
+					break;
+				case N: set(xu, yl, get_strictest_bound_type(xut, ylt), xl, yl, get_strictest_bound_type(xlt, ylt)); break;
+				case P: set(xl, yu, get_strictest_bound_type(xlt, yut), xu, yu, get_strictest_bound_type(xut, yut)); break;
+				case Z: set_zero(ylt, yut); break;
+			}
+			break;
+		case N:
+			switch (classify(b)) {
+				case M: set(xl, yu, get_strictest_bound_type(xlt, yut), xl, yl, get_strictest_bound_type(xlt, ylt)); break;
+				case N: set(xu, yu, get_strictest_bound_type(xut, yut), xl, yl, get_strictest_bound_type(xlt, ylt)); break;
+				case P: set(xl, yu, get_strictest_bound_type(xlt, yut), xu, yl, get_strictest_bound_type(xut, ylt)); break;
+				case Z: set_zero(get_strictest_bound_type(xut, yut), get_strictest_bound_type(xut, ylt)); break;
+			}
+			break;
+		case P:
+			switch (classify(b)) {
+				case M: set(xu, yl, get_strictest_bound_type(xut, ylt), xu, yu, get_strictest_bound_type(xut, yut)); break;
+				case N: set(xu, yl, get_strictest_bound_type(xut, ylt), xl, yu, get_strictest_bound_type(xlt, yut)); break;
+				case P: set(xl, yl, get_strictest_bound_type(xlt, ylt), xu, yu, get_strictest_bound_type(xut, yut)); break;
+				case Z: set_zero(ylt, yut); break;
+			}
+			break;
+		case Z:
+			set_zero(xlt, xut);
+			break;
+	}
+	if (carl::is_zero(s.lower) || carl::is_zero(s.upper)) {
+		bool zero = a.contains(carl::constant_zero<mpq_class>().get()) || b.contains(carl::constant_zero<mpq_class>().get());
+		if (zero && carl::is_zero(s.lower)) lowerType = BoundType::WEAK;
+		if (zero && carl::is_zero(s.upper)) upperType = BoundType::WEAK;
+	}
+	detail_inplace::store(s, lowerType, upperType, res);
+}
+
+/**
+ * Sets res to a / n. n must not be zero.
+ */
+template<typename Number>
+inline void div(const Interval<Number>& a, const Number& n, Interval<Number>& res) {
+	res = a / n;
+}
+inline void div(const Interval<mpq_class>& a, const mpq_class& n, Interval<mpq_class>& res) {
+	assert(!carl::is_zero(n));
+	if (!detail_inplace::is_bounded(a)) {
+		res = a / n;
+		return;
+	}
+	auto& s = detail_inplace::scratch();
+	BoundType lowerType = a.lower_bound_type();
+	BoundType upperType = a.upper_bound_type();
+	if (n > 0) {
+		mpq_div(s.lower.get_mpq_t(), a.lower().get_mpq_t(), n.get_mpq_t());
+		mpq_div(s.upper.get_mpq_t(), a.upper().get_mpq_t(), n.get_mpq_t());
+	} else {
+		mpq_div(s.lower.get_mpq_t(), a.upper().get_mpq_t(), n.get_mpq_t());
+		mpq_div(s.upper.get_mpq_t(), a.lower().get_mpq_t(), n.get_mpq_t());
+		std::swap(lowerType, upperType);
+	}
+	detail_inplace::store(s, lowerType, upperType, res);
+}
+
+/**
+ * Sets res to a / b, see Interval::div(). b must not contain zero.
+ */
+template<typename Number>
+inline void div(const Interval<Number>& a, const Interval<Number>& b, Interval<Number>& res) {
+	res = a.div(b);
+}
+
+/**
+ * Sets res1 (and res2, if a split occurs) to a / b, see Interval::div_ext().
+ * @return True if a split occurred.
+ */
+template<typename Number>
+inline bool div_ext(const Interval<Number>& a, const Interval<Number>& b, Interval<Number>& res1, Interval<Number>& res2) {
+	return a.div_ext(b, res1, res2);
+}
+
+/**
+ * Sets res to |a|, see Interval::abs().
+ */
+template<typename Number>
+inline void abs(const Interval<Number>& a, Interval<Number>& res) {
+	res = a.abs();
+}
+inline void abs(const Interval<mpq_class>& a, Interval<mpq_class>& res) {
+	if (!detail_inplace::is_bounded(a) || a.contains(carl::constant_zero<mpq_class>().get())) {
+		res = a.abs();
+	} else if (mpq_sgn(a.upper().get_mpq_t()) < 0) {
+		neg(a, res);
+	} else if (&a != &res) {
+		// Assigning the bounds reuses the memory of res.
+		detail_inplace::lower(res) = a.lower();
+		detail_inplace::upper(res) = a.upper();
+		res.set_lower_bound_type(a.lower_bound_type());
+		res.set_upper_bound_type(a.upper_bound_type());
+	}
+}
+
+/**
+ * Sets res to sqrt(a), see carl::sqrt(). Only available for floating point numbers.
+ */
+template<typename Number>
+inline void sqrt(const Interval<Number>& a, Interval<Number>& res) {
+	res = carl::sqrt(a);
+}
+
+/**
+ * Sets res to a^exp.
+ */
+template<typename Number, typename Integer>
+inline void pow(const Interval<Number>& a, Integer exp, Interval<Number>& res) {
+	res = carl::pow(a, exp);
+}
+template<typename Integer>
+inline void pow(const Interval<mpq_class>& a, Integer exp, Interval<mpq_class>& res) {
+	if (a.is_empty() || !detail_inplace::is_bounded(a)) {
+		res = carl::pow(a, exp);
+		return;
+	}
+	auto& s = detail_inplace::scratch();
+	auto e = static_cast<unsigned long>(exp);
+	BoundType lowerType = a.lower_bound_type();
+	BoundType upperType = a.upper_bound_type();
+	if (exp % 2 == 0) {
+		// The bound with the larger absolute value becomes the upper bound.
+		bool swap;
+		if (mpq_sgn(a.lower().get_mpq_t()) >= 0) {
+			swap = false;
+		} else if (mpq_sgn(a.upper().get_mpq_t()) <= 0) {
+			swap = a.lower() < a.upper();
+		} else {
+			mpq_neg(s.tmp.get_mpq_t(), a.upper().get_mpq_t());
+			swap = a.lower() < s.tmp;
+		}
+		const mpq_class& small = swap ? a.upper() : a.lower();
+		const mpq_class& large = swap ? a.lower() : a.upper();
+		if (swap) std::swap(lowerType, upperType);
+		if (a.contains(carl::constant_zero<mpq_class>().get())) {
+			mpq_set_ui(s.lower.get_mpq_t(), 0, 1);
+			lowerType = BoundType::WEAK;
+		} else {
+			detail_inplace::pow(s.lower.get_mpq_t(), small.get_mpq_t(), e);
+		}
+		detail_inplace::pow(s.upper.get_mpq_t(), large.get_mpq_t(), e);
+	} else {
+		detail_inplace::pow(s.lower.get_mpq_t(), a.lower().get_mpq_t(), e);
+		detail_inplace::pow(s.upper.get_mpq_t(), a.upper().get_mpq_t(), e);
+	}
+	detail_inplace::store(s, lowerType, upperType, res);
+}
+
+
+/**
+ * Variants of the operations above that use the result as first operand.
+ */
+template<typename Number>
+inline void add_assign(Interval<Number>& res, const Interval<Number>& b) {
+	add(res, b, res);
+}
+template<typename Number>
+inline void add_assign(Interval<Number>& res, const Number& n) {
+	add(res, n, res);
+}
+template<typename Number>
+inline void sub_assign(Interval<Number>& res, const Interval<Number>& b) {
+	sub(res, b, res);
+}
+template<typename Number>
+inline void mul_assign(Interval<Number>& res, const Interval<Number>& b) {
+	mul(res, b, res);
+}
+template<typename Number>
+inline void mul_assign(Interval<Number>& res, const Number& n) {
+	mul(res, n, res);
+}
+template<typename Number>
+inline void div_assign(Interval<Number>& res, const Interval<Number>& b) {
+	div(res, b, res);
+}
+template<typename Number>
+inline void div_assign(Interval<Number>& res, const Number& n) {
+	div(res, n, res);
+}
+template<typename Number>
+inline void neg_assign(Interval<Number>& res) {
+	neg(res, res);
+}
+template<typename Number>
+inline void abs_assign(Interval<Number>& res) {
+	abs(res, res);
+}
+/// Overloads pow_assign() from power.h.
+template<typename Integer>
+inline void pow_assign(Interval<mpq_class>& res, Integer exp) {
+	pow(res, exp, res);
+}
+
+}
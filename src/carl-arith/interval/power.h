@@ -69,7 +69,7 @@ Interval<Number> sqrt(const Interval<Number>& i) {
 
 template<typename Number, EnableIf<std::is_floating_point<Number>> = dummy>
 void sqrt_assign(Interval<Number>& i) {
-	i = sqrt(i, exp);
+	i = sqrt(i);
 }
 
 }
\ No newline at end of file
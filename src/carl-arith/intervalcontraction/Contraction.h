@@ -7,9 +7,11 @@
 
 #pragma once
 #include <carl-arith/interval/Interval.h>
+#include <carl-arith/interval/IntervalSet.h>
 #include <carl-arith/interval/set_theory.h>
 #include <carl-arith/core/Sign.h>
 #include <carl-arith/poly/umvpoly/functions/horner/MultivariateHorner.h>
+#include <carl-arith/poly/umvpoly/functions/AffineEvaluation.h>
 #include <carl-arith/poly/umvpoly/functions/IntervalEvaluation.h>
 #include <algorithm>
 
@@ -141,7 +143,7 @@ namespace carl {
                 }
             }
             
-            void addRoot( const Interval<double>& _interv, const Interval<double>& _varInterval, std::vector<Interval<double>>& _result ) const
+            void addRoot( const Interval<double>& _interv, const Interval<double>& _varInterval, IntervalSet<double>& _result ) const
             {
                 Interval<double> tmp = _interv.root((int) mRoot);
 				CARL_LOG_DEBUG("carl.contraction", mRoot << "th root of " << _interv << " = " << tmp);
@@ -156,15 +158,13 @@ namespace carl {
                         }
                         rootA = set_intersection(rootA, _varInterval);
 						CARL_LOG_DEBUG("carl.contraction", "first intersected with " << _varInterval << " = " << rootA);
-                        if( !rootA.is_empty() )
-                            _result.push_back(std::move(rootA));
+                        _result.insert(rootA);
                         if (mVar.type() == VariableType::VT_INT) {
                             rootB = rootB.integral_part();
                         }
                         rootB = set_intersection(rootB, _varInterval);
 						CARL_LOG_DEBUG("carl.contraction", "second intersected with " << _varInterval << " = " << rootB);
-                        if( !rootB.is_empty() )
-                            _result.push_back(std::move(rootB));
+                        _result.insert(rootB);
                     }
                     else
                     {
@@ -173,8 +173,7 @@ namespace carl {
                             rootA = rootA.integral_part();
                         }
                         rootA = set_intersection(rootA, _varInterval);
-                        if( !rootA.is_empty() )
-                            _result.push_back(std::move(rootA));
+                        _result.insert(rootA);
                     }
                 }
                 else
@@ -182,21 +181,20 @@ namespace carl {
                     if (mVar.type() == VariableType::VT_INT) {
                         tmp = tmp.integral_part();
                     }
-                    _result.push_back( std::move(tmp) );
+                    _result.insert( tmp );
                 }
             }
             
             /**
              * Evaluates this solution formula for the given mapping of the variables occurring in the solution formula to double intervals.
              * @param intervals The mapping of the variables occurring in the solution formula to double intervals
-             * @param resA The first interval of the result.
-             * @param resB The second interval of the result.
-             * @return true, if the second interval is not empty. (the first interval must then be also nonempty)
+             * @return The values of the variable satisfying the solution formula.
              */
-            std::vector<Interval<double>> evaluate(const Interval<double>::evalintervalmap& intervals) const
+            template<typename IntervalMap>
+            IntervalSet<double> evaluate(const IntervalMap& intervals) const
             {
                 // evaluate monomial
-                std::vector<Interval<double>> result;
+                IntervalSet<double> result;
                 assert( intervals.find(mVar) != intervals.end() );
                 const Interval<double>& varInterval = intervals.at(mVar);
                 Interval<double> numerator = carl::evaluate(mNumerator, intervals);
@@ -251,7 +249,8 @@ namespace carl {
         std::map<Variable, Polynomial> mDerivatives;
         #endif
         std::map<Variable, VarSolutionFormula<Polynomial>> mVarSolutionFormulas;
-        std::map<Polynomial, MultivariateHorner<Polynomial,strategy>> mHornerSchemes;
+        /// How the polynomials are evaluated over the intervals.
+        IntervalEvaluationMode mEvaluationMode = IntervalEvaluationMode::INTERVAL;
 
     public:
         Contraction() = delete;
@@ -263,8 +262,7 @@ namespace carl {
             mHornerForm(constraint),
             #endif
             mDerivatives(),
-            mVarSolutionFormulas(),
-			mHornerSchemes()
+            mVarSolutionFormulas()
         {}
 
         Contraction(const Polynomial& constraint, const Polynomial& _original ):
@@ -275,8 +273,7 @@ namespace carl {
             mHornerForm( mpOriginal == nullptr ? constraint :  _original ),
             #endif
             mDerivatives(),
-            mVarSolutionFormulas() ,
-			mHornerSchemes()
+            mVarSolutionFormulas()
         {}
         Contraction(const Contraction&) = delete;
         
@@ -289,7 +286,7 @@ namespace carl {
             #endif
             mDerivatives(std::move(_contraction.mDerivatives)),
             mVarSolutionFormulas(std::move(_contraction.mVarSolutionFormulas)),
-			mHornerSchemes(std::move(_contraction.mHornerSchemes))
+            mEvaluationMode(_contraction.mEvaluationMode)
         {
             _contraction.mpOriginal = nullptr;
         }
@@ -308,7 +305,26 @@ namespace carl {
             return mpOriginal == nullptr ? mConstraint : *mpOriginal;
         }
 
-        bool operator()(const Interval<double>::evalintervalmap& intervals, Variable::Arg variable, Interval<double>& resA, Interval<double>& resB, bool useNiceCenter = false, bool usePropagation = false)
+        IntervalEvaluationMode evaluation_mode() const
+        {
+            return mEvaluationMode;
+        }
+
+        /**
+         * Sets how the constraint and its derivatives are evaluated in the newton step.
+         * IntervalEvaluationMode::AFFINE yields tighter contractions for constraints with many dependent occurrences of a variable.
+         */
+        void set_evaluation_mode(IntervalEvaluationMode mode)
+        {
+            mEvaluationMode = mode;
+        }
+
+        /**
+         * Contracts the interval of the given variable.
+         * @param intervals The intervals of all variables, either as an Interval<double>::evalintervalmap or a DenseAssignment<Interval<double>>.
+         */
+        template<typename IntervalMap>
+        bool operator()(const IntervalMap& intervals, Variable::Arg variable, Interval<double>& resA, Interval<double>& resB, bool useNiceCenter = false, bool usePropagation = false)
         {
             bool splitOccurredInContraction = false;
             if( !usePropagation || mpOriginal == nullptr || !mConstraint.is_linear() )
@@ -340,9 +356,9 @@ namespace carl {
                 #endif
 
                 #ifdef USE_HORNER
-                splitOccurredInContraction = Operator<Polynomial>::contract(intervals, variable, mHornerForm, (*it).second, resA, resB, useNiceCenter);
+                splitOccurredInContraction = Operator<Polynomial>::contract(intervals, variable, mHornerForm, (*it).second, resA, resB, useNiceCenter, mEvaluationMode);
                 #else
-                splitOccurredInContraction = Operator<Polynomial>::contract(intervals, variable, (mpOriginal == nullptr ? mConstraint : *mpOriginal), (*it).second, resA, resB, useNiceCenter);
+                splitOccurredInContraction = Operator<Polynomial>::contract(intervals, variable, (mpOriginal == nullptr ? mConstraint : *mpOriginal), (*it).second, resA, resB, useNiceCenter, mEvaluationMode);
                 #endif
             }
             else
@@ -364,123 +380,24 @@ namespace carl {
                 }
                 
                 // calculate result of propagation
-                std::vector<Interval<double>> resultPropagation = const_iterator_VarSolutionFormula->second.evaluate( intervals );
+                IntervalSet<double> resultPropagation = const_iterator_VarSolutionFormula->second.evaluate( intervals );
                 
                 #ifdef CONTRACTION_DEBUG
                 std::cout << "  propagation result: " << resultPropagation << std::endl;
                 #endif
 
-                if( resultPropagation.empty() )
-                {
-                    resA = Interval<double>::empty_interval();
-                    resB = Interval<double>::empty_interval();
-					CARL_LOG_DEBUG("carl.contraction", "  after propagation: " << resA << " / " << resB);
-                    return false;
-                }
-
                 // intersect with result of contraction
-                std::vector<Interval<double>> resultingIntervals;
+                IntervalSet<double> contracted(resA);
                 if( splitOccurredInContraction )
-                {   
-                    Interval<double> tmp;
-                    for( const auto& i : resultPropagation )
-                    {
-                        tmp = carl::set_intersection(i, resA);
-						CARL_LOG_DEBUG("carl.contraction", "  intersection(" << i << ", " << resA << ") = " << tmp);
-                        if( !tmp.is_empty() )
-                            resultingIntervals.push_back(tmp);
-                        tmp = carl::set_intersection(i, resB);
-						CARL_LOG_DEBUG("carl.contraction", "  intersection(" << i << ", " << resB << ") = " << tmp);
-                        if( !tmp.is_empty() )
-                            resultingIntervals.push_back(tmp);
-                    }
-                }
-
-                else 
-                {
-                    Interval<double> tmp;
-                    for( const auto& i : resultPropagation )
-                    {
-                        tmp = carl::set_intersection(i, resA);
-						CARL_LOG_DEBUG("carl.contraction", "  intersection(" << i << ", " << resA << ") = " << tmp);
-                        if( !tmp.is_empty() )
-                            resultingIntervals.push_back(tmp);
-                    }
-                }
-                if( resultingIntervals.empty() )
-                {
-                    resA = Interval<double>::empty_interval();
-                    resB = Interval<double>::empty_interval();
-                    CARL_LOG_DEBUG("carl.contraction", "  after propagation: " << resA << " / " << resB);
-                    return false;
-                }
-                if( resultingIntervals.size() == 1 )
                 {
-                    resA = resultingIntervals[0];
-                    resB = Interval<double>::empty_interval();
-                    CARL_LOG_DEBUG("carl.contraction", "  after propagation: " << resA << " / " << resB);
-                    return false;
+                    contracted.insert(resB);
                 }
-                if( resultingIntervals.size() == 2 )
-                {
-                    if( resultingIntervals[0] < resultingIntervals[1] )
-                    {
-                        resA = resultingIntervals[0];
-                        resB = resultingIntervals[1];
-                    }
-                    else
-                    {
-                        assert(resultingIntervals[1] < resultingIntervals[0]);
-                        resA = resultingIntervals[1];
-                        resB = resultingIntervals[0];
-                    }
-                    CARL_LOG_DEBUG("carl.contraction", "  after propagation: " << resA << " / " << resB);
-                    return true;
-                }
-                else
-                {
-                    std::sort( resultPropagation.begin(), resultPropagation.end(), 
-                              [](const Interval<double>& i,const Interval<double> j) 
-                              { if(i<j){return true;} else { assert(j<i); return false; } }
-                             );
-                    auto intervalBeforeBiggestGap = resultPropagation.begin();
-                    auto iter = resultPropagation.begin();
-                    ++iter;
-                    double bestDistance = intervalBeforeBiggestGap->distance(*iter);
-                    for( ; iter != resultPropagation.end(); ++iter )
-                    {
-                        auto jter = iter;
-                        ++jter;
-                        if( jter == resultPropagation.end() )
-                        {
-                            break;
-                        }
-                        else
-                        {
-                            double distance = iter->distance(*jter);
-                            if( bestDistance < distance )
-                            {
-                                bestDistance = distance;
-                                intervalBeforeBiggestGap = iter;
-                            }
-                        }
-                    }
-                    resA = *intervalBeforeBiggestGap;
-                    for( iter = resultPropagation.begin(); iter != intervalBeforeBiggestGap; ++iter )
-                    {
-                        resA = resA.convex_hull( *iter );
-                    }
-                    ++iter;
-                    resB = *iter;
-                    for( ; iter != resultPropagation.end(); ++iter )
-                    {
-                        resB = resB.convex_hull( *iter );
-                    }
-                    #ifdef CONTRACTION_DEBUG
-                    std::cout << "  after propagation: " << resA; if( !resB.is_empty() ) { std::cout << " and " << resB; } std::cout << std::endl;                            
-                    #endif
-                    return true;
-                }              
+                IntervalSet<double> resultingIntervals = set_intersection(resultPropagation, contracted);
+                CARL_LOG_DEBUG("carl.contraction", "  intersection(" << resultPropagation << ", " << contracted << ") = " << resultingIntervals);
+                // at most two intervals can be returned, hence more intervals are joined at the biggest gap
+                bool split = resultingIntervals.split_at_largest_gap(resA, resB);
+                CARL_LOG_DEBUG("carl.contraction", "  after propagation: " << resA << " / " << resB);
+                return split;
             }
             return splitOccurredInContraction;
         }
@@ -490,14 +407,15 @@ namespace carl {
     class SimpleNewton {
     public:
         
-        template <typename evalType>
-        bool contract(const Interval<double>::evalintervalmap& intervals, 
+        template <typename evalType, typename IntervalMap>
+        bool contract(const IntervalMap& intervals, 
             Variable::Arg variable, 
             const evalType& constraint, 
             const evalType& derivative, 
             Interval<double>& resA, 
             Interval<double>& resB, 
-            bool useNiceCenter = false) 
+            bool useNiceCenter = false,
+            IntervalEvaluationMode mode = IntervalEvaluationMode::INTERVAL) 
         {
             bool splitOccurred = false;
             
@@ -517,7 +435,7 @@ namespace carl {
 			#endif
 			
             // Create map for replacement of variables by intervals and replacement of center by point interval
-            typename Interval<double>::evalintervalmap substitutedIntervalMap = intervals;
+            IntervalMap substitutedIntervalMap = intervals;
             substitutedIntervalMap[variable] = centerInterval;
 
             Interval<double> numerator (0);
@@ -526,8 +444,8 @@ namespace carl {
      
             
             // Create Newton Operator
-            numerator =   carl::evaluate(constraint, substitutedIntervalMap);
-            denominator = carl::evaluate(derivative, intervals);
+            numerator =   carl::evaluate(constraint, substitutedIntervalMap, mode);
+            denominator = carl::evaluate(derivative, intervals, mode);
 
 
             Interval<double> result1, result2;
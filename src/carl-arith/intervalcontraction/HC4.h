@@ -0,0 +1,195 @@
+#pragma once
+
+#include <carl-arith/core/DenseAssignment.h>
+#include <carl-arith/interval/Interval.h>
+#include <carl-arith/interval/set_theory.h>
+#include <carl-arith/poly/umvpoly/functions/EvaluationPlan.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace carl {
+
+/**
+ * HC4-revise contractor for a constraint p in range.
+ *
+ * The polynomial is compiled into an EvaluationPlan, i.e. a DAG where every variable and every power of a variable occurs only once.
+ * A contraction consists of a forward pass that evaluates all nodes on the box, intersecting the root with the range,
+ * and a backward pass that projects the interval of every node onto its children.
+ * Since the nodes are processed in reverse topological order, every node has been narrowed by all its parents before it is projected.
+ * Finally, the intervals of the variable nodes are written back to the box, contracting all variables of the constraint at once.
+ *
+ * Compiling the contractor from a MultivariateHorner scheme retains the structure of the scheme, which usually reduces the dependency problem.
+ */
+template<typename Coeff>
+class HC4Contractor {
+	using Plan = EvaluationPlan<Coeff>;
+	using Op = typename Plan::Op;
+
+	std::shared_ptr<const Plan> mPlan;
+	std::vector<Interval<double>> mConstants;
+	std::vector<Interval<double>> mNodes;
+
+	static bool intersect(Interval<double>& target, const Interval<double>& i) {
+		target = set_intersection(target, i);
+		return !target.is_empty();
+	}
+	/// Intersects target with the union of a and b.
+	static bool intersect(Interval<double>& target, const Interval<double>& a, const Interval<double>& b) {
+		Interval<double> ta = set_intersection(target, a);
+		Interval<double> tb = set_intersection(target, b);
+		if (ta.is_empty()) target = tb;
+		else if (tb.is_empty()) target = ta;
+		else target = ta.convex_hull(tb);
+		return !target.is_empty();
+	}
+	/// Narrows x with respect to z = x * y.
+	static bool project_mul(const Interval<double>& z, Interval<double>& x, const Interval<double>& y) {
+		Interval<double> a;
+		Interval<double> b;
+		if (z.div_ext(y, a, b)) {
+			return intersect(x, a, b);
+		}
+		return intersect(x, a);
+	}
+	/// Narrows x with respect to z = x^exp.
+	static bool project_pow(const Interval<double>& z, Interval<double>& x, unsigned exp) {
+		if (exp % 2 == 0) {
+			Interval<double> root = z.root(static_cast<int>(exp));
+			if (root.is_empty()) return false;
+			return intersect(x, root, -root);
+		}
+		// Odd roots of unbounded intervals are not supported by the interval implementation.
+		if (z.is_unbounded()) return true;
+		return intersect(x, z.root(static_cast<int>(exp)));
+	}
+
+	void forward(const DenseAssignment<Interval<double>>& box) {
+		std::copy(mConstants.begin(), mConstants.end(), mNodes.begin());
+		std::size_t reg = mConstants.size();
+		for (const auto& i: mPlan->instructions()) {
+			switch (i.op) {
+				case Op::VAR:
+					mNodes[reg] = box.at(mPlan->variables()[i.a]);
+					break;
+				case Op::POW:
+					mNodes[reg] = carl::pow(mNodes[i.a], i.exp);
+					break;
+				case Op::MUL:
+					mNodes[reg] = mNodes[i.a] * mNodes[i.b];
+					break;
+				case Op::ADD:
+					mNodes[reg] = mNodes[i.a] + mNodes[i.b];
+					break;
+			}
+			++reg;
+		}
+	}
+
+	bool backward() {
+		const auto& instructions = mPlan->instructions();
+		for (std::size_t n = instructions.size(); n > 0; --n) {
+			const auto& i = instructions[n - 1];
+			const Interval<double>& z = mNodes[mConstants.size() + n - 1];
+			switch (i.op) {
+				case Op::VAR:
+					// All parents have been processed, hence the variable is final.
+					if (mPlan->variables()[i.a].type() == VariableType::VT_INT) {
+						auto& node = mNodes[mConstants.size() + n - 1];
+						node = node.integral_part();
+						if (node.is_empty()) return false;
+					}
+					break;
+				case Op::POW:
+					if (!project_pow(z, mNodes[i.a], i.exp)) return false;
+					break;
+				case Op::MUL:
+					if (!project_mul(z, mNodes[i.a], mNodes[i.b])) return false;
+					if (!project_mul(z, mNodes[i.b], mNodes[i.a])) return false;
+					break;
+				case Op::ADD:
+					if (!intersect(mNodes[i.a], z - mNodes[i.b])) return false;
+					if (!intersect(mNodes[i.b], z - mNodes[i.a])) return false;
+					break;
+			}
+		}
+		return true;
+	}
+
+	void init() {
+		for (const auto& c: mPlan->constants()) {
+			mConstants.emplace_back(c);
+		}
+		mNodes.resize(mConstants.size() + mPlan->instructions().size());
+	}
+
+public:
+	template<typename Policy, typename Ordering>
+	explicit HC4Contractor(const MultivariatePolynomial<Coeff, Policy, Ordering>& p):
+		mPlan(std::make_shared<const Plan>(p))
+	{
+		init();
+	}
+	template<typename Poly, typename Strategy>
+	explicit HC4Contractor(const MultivariateHorner<Poly, Strategy>& h):
+		mPlan(std::make_shared<const Plan>(h))
+	{
+		init();
+	}
+	/**
+	 * Uses a shared plan, e.g. from the HornerCache.
+	 */
+	explicit HC4Contractor(std::shared_ptr<const Plan> plan):
+		mPlan(std::move(plan))
+	{
+		assert(mPlan);
+		init();
+	}
+
+	/// The variables contracted by this contractor.
+	const std::vector<Variable>& variables() const {
+		return mPlan->variables();
+	}
+
+	/**
+	 * Contracts the box with respect to p in range.
+	 * Every variable of p must be assigned in the box.
+	 * @param box The box, contracted in-place.
+	 * @param range The range of p, by default [0,0].
+	 * @return false, if the box has been found to contain no solution. The box is left unchanged in this case.
+	 */
+	bool operator()(DenseAssignment<Interval<double>>& box, const Interval<double>& range = Interval<double>(0)) {
+		forward(box);
+		if (!intersect(mNodes[mPlan->result()], range)) {
+			CARL_LOG_TRACE("carl.contraction", "Forward evaluation " << mNodes[mPlan->result()] << " is disjoint from " << range);
+			return false;
+		}
+		if (!backward()) {
+			CARL_LOG_TRACE("carl.contraction", "Backward projection yields an empty interval");
+			return false;
+		}
+		std::size_t reg = mConstants.size();
+		for (const auto& i: mPlan->instructions()) {
+			if (i.op == Op::VAR) {
+				box.at(mPlan->variables()[i.a]) = mNodes[reg];
+			}
+			++reg;
+		}
+		return true;
+	}
+
+	/**
+	 * Contracts the box with respect to p in range.
+	 */
+	bool operator()(Interval<double>::evalintervalmap& box, const Interval<double>& range = Interval<double>(0)) {
+		DenseAssignment<Interval<double>> dense(box);
+		if (!(*this)(dense, range)) return false;
+		for (const auto& v: variables()) {
+			box[v] = dense.at(v);
+		}
+		return true;
+	}
+};
+
+}
@@ -0,0 +1,308 @@
+#pragma once
+
+#include "Contraction.h"
+#include "HC4.h"
+#include "PropagationStatistics.h"
+
+#include <carl-arith/constraint/BasicConstraint.h>
+#include <carl-arith/core/DenseAssignment.h>
+#include <carl-arith/core/VariablePool.h>
+#include <carl-arith/core/Variables.h>
+#include <carl-arith/interval/Interval.h>
+#include <carl-arith/interval/set_theory.h>
+#include <carl-arith/poly/umvpoly/functions/horner/HornerCache.h>
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+namespace carl {
+
+struct PropagationSettings {
+	/// Minimal relative width reduction of a variable for its constraints to be scheduled again.
+	double threshold = 0.05;
+	/// Maximal number of contractions within a single call to propagate().
+	std::size_t max_contractions = 1000;
+	/// Whether to contract all variables of a constraint at once using HC4Contractor.
+	bool use_hc4 = false;
+	/// Whether to contract single variables using Contraction.
+	bool use_contraction = true;
+	/// Whether HC4 contractors use the horner scheme from the HornerCache instead of the expanded polynomial.
+	bool use_horner = true;
+};
+
+/**
+ * Interval constraint propagation over a set of polynomial constraints.
+ *
+ * Every pair of a constraint and one of its variables forms a candidate, which is contracted using a Contraction object.
+ * Candidates are kept in a worklist that is prioritized by the relative width reduction that caused them to be scheduled:
+ * whenever the interval of a variable shrinks by at least the threshold, all other candidates of constraints containing this variable are scheduled again.
+ * Propagation stops if the worklist is empty, i.e. a fixpoint up to the threshold is reached, or the number of contractions exceeds the limit.
+ *
+ * If a contraction yields two intervals, their convex hull is used: splitting boxes is left to the caller.
+ * If enabled, every constraint additionally forms a candidate that contracts all its variables at once with an HC4Contractor.
+ *
+ * Constraints of the form p ~ 0 with ~ other than = are handled by a slack variable s, contracting p - s = 0.
+ * The slack is initialized with the intersection of the range allowed by ~ and the interval evaluation of p on the box.
+ */
+template<typename Polynomial, template<typename> class Operator = SimpleNewton>
+class Propagation {
+public:
+	using Box = DenseAssignment<Interval<double>>;
+	using ContractionType = Contraction<Operator, Polynomial>;
+private:
+	using HC4Type = HC4Contractor<typename Polynomial::CoeffType>;
+	struct Candidate {
+		std::size_t constraint;
+		/// The variable to contract, or NO_VARIABLE to contract all variables using HC4.
+		Variable variable;
+	};
+
+	PropagationSettings mSettings;
+	std::vector<Polynomial> mPolynomials;
+	std::vector<std::unique_ptr<ContractionType>> mContractions;
+	/// HC4 contractors, created on first use.
+	std::vector<std::unique_ptr<HC4Type>> mHC4Contractors;
+	std::vector<Interval<double>> mOldIntervals;
+	std::vector<Candidate> mCandidates;
+	/// For every variable the candidates of all constraints containing it.
+	DenseAssignment<std::vector<std::size_t>> mVariableCandidates;
+	struct Slack {
+		Variable variable;
+		Interval<double> range;
+		Polynomial polynomial;
+	};
+	/// Slack variables with their range and the polynomial they stand for.
+	std::vector<Slack> mSlacks;
+
+	/// Relative width reduction from old to res, where res is a subset of old.
+	static double gain(const Interval<double>& old, const Interval<double>& res) {
+		if (old.is_unbounded()) {
+			return res == old ? 0 : 1;
+		}
+		double width = old.diameter();
+		if (width <= 0) return 0;
+		return 1 - res.diameter() / width;
+	}
+
+public:
+	explicit Propagation(const PropagationSettings& settings = PropagationSettings()):
+		mSettings(settings)
+	{}
+
+	/**
+	 * Adds the constraint p = 0.
+	 * @return The index of the constraint.
+	 */
+	std::size_t add_constraint(const Polynomial& p) {
+		std::size_t id = mContractions.size();
+		mPolynomials.push_back(p);
+		mContractions.emplace_back(std::make_unique<ContractionType>(p));
+		mHC4Contractors.emplace_back(nullptr);
+		carlVariables vars;
+		carl::variables(p, vars);
+		std::size_t hc4 = mCandidates.size();
+		mCandidates.push_back(Candidate{id, Variable::NO_VARIABLE});
+		for (const auto& v: vars.as_vector()) {
+			std::size_t candidate = mCandidates.size();
+			mCandidates.push_back(Candidate{id, v});
+			mVariableCandidates[v].push_back(hc4);
+			mVariableCandidates[v].push_back(candidate);
+		}
+		CARL_LOG_DEBUG("carl.contraction", "Added constraint " << id << ": " << p << " = 0");
+		return id;
+	}
+
+	/**
+	 * Adds the constraint p in range, using a fresh slack variable unless range is [0,0].
+	 * @return The index of the constraint.
+	 */
+	std::size_t add_constraint(const Polynomial& p, const Interval<double>& range) {
+		if (range.is_point_interval() && range.lower() == 0) {
+			return add_constraint(p);
+		}
+		Variable slack = fresh_real_variable();
+		mSlacks.push_back(Slack{slack, range, p});
+		return add_constraint(p - Polynomial(slack));
+	}
+
+	/**
+	 * Adds the constraint c. Constraints with relation != do not contract and are ignored.
+	 * Strict relations are relaxed to weak ones.
+	 * @return The index of the constraint, or std::nullopt if it was ignored.
+	 */
+	std::optional<std::size_t> add_constraint(const BasicConstraint<Polynomial>& c) {
+		switch (c.relation()) {
+			case Relation::EQ:
+				return add_constraint(c.lhs());
+			case Relation::NEQ:
+				return std::nullopt;
+			case Relation::LESS:
+			case Relation::LEQ:
+				return add_constraint(c.lhs(), Interval<double>(0, BoundType::INFTY, 0, BoundType::WEAK));
+			case Relation::GREATER:
+			case Relation::GEQ:
+				return add_constraint(c.lhs(), Interval<double>(0, BoundType::WEAK, 0, BoundType::INFTY));
+		}
+		return std::nullopt;
+	}
+
+	std::size_t size() const {
+		return mContractions.size();
+	}
+	/// The contraction object of a constraint.
+	ContractionType& contraction(std::size_t constraint) {
+		assert(constraint < mContractions.size());
+		return *mContractions[constraint];
+	}
+	/// The HC4 contractor of a constraint.
+	HC4Type& hc4_contractor(std::size_t constraint) {
+		assert(constraint < mHC4Contractors.size());
+		if (!mHC4Contractors[constraint]) {
+			if (mSettings.use_horner) {
+				mHC4Contractors[constraint] = std::make_unique<HC4Type>(HornerCache<Polynomial>::getInstance().plan(mPolynomials[constraint]));
+			} else {
+				mHC4Contractors[constraint] = std::make_unique<HC4Type>(mPolynomials[constraint]);
+			}
+		}
+		return *mHC4Contractors[constraint];
+	}
+	const PropagationSettings& settings() const {
+		return mSettings;
+	}
+	PropagationSettings& settings() {
+		return mSettings;
+	}
+
+	/**
+	 * Contracts the box until a fixpoint (with respect to the threshold) is reached.
+	 * Every variable of the constraints must be assigned in the box.
+	 * @param box The box, contracted in-place.
+	 * @return false, if the box has been found to contain no solution.
+	 */
+	bool propagate(Box& box) {
+		CARL_TIME_START(start);
+		bool res = true;
+		for (const auto& s: mSlacks) {
+			auto range = set_intersection(s.range, carl::evaluate(s.polynomial, box));
+			if (range.is_empty()) res = false;
+			box.insert_or_assign(s.variable, range);
+		}
+		if (res) {
+			res = run(box);
+		} else {
+			CARL_LOG_DEBUG("carl.contraction", "Some constraint is infeasible on " << box);
+		}
+		for (const auto& s: mSlacks) {
+			box.erase(s.variable);
+		}
+		CARL_TIME_FINISH(propagation::statistics().propagation, start);
+		CARL_CALL_STATISTICS(if (!res) propagation::statistics().conflicts++);
+		return res;
+	}
+
+	/**
+	 * Contracts the box until a fixpoint (with respect to the threshold) is reached.
+	 */
+	bool propagate(Interval<double>::evalintervalmap& box) {
+		Box dense(box);
+		bool res = propagate(dense);
+		for (auto& [var, interval]: box) {
+			interval = dense.at(var);
+		}
+		return res;
+	}
+
+private:
+	bool run(Box& box) {
+		// Priority of every queued candidate, negative if not queued. Outdated queue entries are skipped.
+		std::vector<double> priority(mCandidates.size(), -1);
+		std::priority_queue<std::pair<double, std::size_t>> queue;
+		auto schedule = [&](std::size_t candidate, double gain) {
+			if (gain > priority[candidate]) {
+				priority[candidate] = gain;
+				queue.emplace(gain, candidate);
+			}
+		};
+		auto enabled = [this](const Candidate& candidate) {
+			return candidate.variable == Variable::NO_VARIABLE ? mSettings.use_hc4 : mSettings.use_contraction;
+		};
+		for (std::size_t c = 0; c < mCandidates.size(); ++c) {
+			if (enabled(mCandidates[c])) schedule(c, 1);
+		}
+
+		std::size_t contractions = 0;
+		while (!queue.empty() && contractions < mSettings.max_contractions) {
+			auto [prio, c] = queue.top();
+			queue.pop();
+			if (prio != priority[c]) continue;
+			priority[c] = -1;
+
+			const Candidate& candidate = mCandidates[c];
+			if (candidate.variable == Variable::NO_VARIABLE) {
+				++contractions;
+				CARL_CALL_STATISTICS(propagation::statistics().contractions++);
+				if (!run_hc4(box, c, schedule, enabled)) return false;
+				continue;
+			}
+			Interval<double> old = box.at(candidate.variable);
+			Interval<double> resA;
+			Interval<double> resB;
+			bool split = (*mContractions[candidate.constraint])(box, candidate.variable, resA, resB);
+			++contractions;
+			CARL_CALL_STATISTICS(propagation::statistics().contractions++);
+			Interval<double> res = resA;
+			if (split) {
+				CARL_CALL_STATISTICS(propagation::statistics().splits++);
+				res = resA.convex_hull(resB);
+			}
+			res = set_intersection(res, old);
+			CARL_LOG_TRACE("carl.contraction", "Contracted " << candidate.variable << " using constraint " << candidate.constraint << ": " << old << " -> " << res);
+			if (res.is_empty()) {
+				CARL_LOG_DEBUG("carl.contraction", "Constraint " << candidate.constraint << " is infeasible on " << box);
+				return false;
+			}
+			double g = gain(old, res);
+			CARL_CALL_STATISTICS(propagation::statistics().width_reduction += g);
+			if (g <= 0) continue;
+			box.at(candidate.variable) = res;
+			if (g < mSettings.threshold) continue;
+			for (std::size_t other: mVariableCandidates[candidate.variable]) {
+				if (other != c && enabled(mCandidates[other])) schedule(other, g);
+			}
+		}
+		CARL_LOG_DEBUG("carl.contraction", "Propagation stopped after " << contractions << " contractions with " << box);
+		return true;
+	}
+
+	template<typename Schedule, typename Enabled>
+	bool run_hc4(Box& box, std::size_t c, Schedule&& schedule, Enabled&& enabled) {
+		auto& hc4 = hc4_contractor(mCandidates[c].constraint);
+		mOldIntervals.clear();
+		for (const auto& v: hc4.variables()) {
+			mOldIntervals.push_back(box.at(v));
+		}
+		if (!hc4(box)) {
+			CARL_LOG_DEBUG("carl.contraction", "Constraint " << mCandidates[c].constraint << " is infeasible on " << box);
+			return false;
+		}
+		double sum = 0;
+		for (std::size_t i = 0; i < mOldIntervals.size(); ++i) {
+			Variable v = hc4.variables()[i];
+			double g = gain(mOldIntervals[i], box.at(v));
+			sum += g;
+			if (g < mSettings.threshold) continue;
+			CARL_LOG_TRACE("carl.contraction", "Contracted " << v << " using constraint " << mCandidates[c].constraint << ": " << mOldIntervals[i] << " -> " << box.at(v));
+			for (std::size_t other: mVariableCandidates[v]) {
+				if (other != c && enabled(mCandidates[other])) schedule(other, g);
+			}
+		}
+		CARL_CALL_STATISTICS(propagation::statistics().width_reduction += sum / static_cast<double>(std::max<std::size_t>(mOldIntervals.size(), 1)));
+		return true;
+	}
+};
+
+}
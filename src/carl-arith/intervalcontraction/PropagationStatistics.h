@@ -0,0 +1,43 @@
+#pragma once
+
+#include <carl-statistics/carl-statistics.h>
+
+#ifdef CARL_DEVOPTION_Statistics
+
+namespace carl {
+namespace propagation {
+
+class PropagationStatistics : public statistics::Statistics {
+public:
+	/// Time spent in propagate().
+	statistics::timer propagation;
+	/// Number of single contractions.
+	std::size_t contractions = 0;
+	/// Sum of the relative width reductions of all contractions.
+	double width_reduction = 0;
+	/// Number of contractions that returned two intervals and had to be joined.
+	std::size_t splits = 0;
+	/// Number of propagations that found the box to be empty.
+	std::size_t conflicts = 0;
+	void collect() {
+		Statistics::addKeyValuePair("propagation", propagation);
+		Statistics::addKeyValuePair("contractions", contractions);
+		Statistics::addKeyValuePair("splits", splits);
+		Statistics::addKeyValuePair("conflicts", conflicts);
+		if (propagation.overall_ms() > 0) {
+			Statistics::addKeyValuePair("contractions_per_second", static_cast<double>(contractions) * 1000 / static_cast<double>(propagation.overall_ms()));
+		}
+		if (contractions > 0) {
+			Statistics::addKeyValuePair("average_width_reduction", width_reduction / static_cast<double>(contractions));
+		}
+	}
+};
+
+static auto& statistics() {
+	static CARL_INIT_STATISTICS(PropagationStatistics, stats, "propagation");
+	return stats;
+}
+
+}
+}
+#endif
@@ -0,0 +1,252 @@
+#pragma once
+
+/**
+ * @file AdaptiveEvaluation.h
+ * Interval evaluation with MPFR at adaptive precision.
+ *
+ * Interval<double> is often too coarse to decide the sign of a polynomial on a small box, while exact rational evaluation is expensive.
+ * AdaptiveMpfrEvaluator sits in between: it evaluates with correctly rounded MPFR intervals, starting with a low precision
+ * and doubling it until the sign of the result is determined or a maximal precision is reached.
+ */
+
+#include <carl-common/config.h>
+
+#ifdef USE_MPFR_FLOAT
+
+#include "EvaluationPlan.h"
+
+#include <carl-arith/core/Sign.h>
+#include <carl-arith/interval/Interval.h>
+
+#include <mpfr.h>
+
+#include <algorithm>
+#include <deque>
+#include <limits>
+#include <map>
+#include <optional>
+
+namespace carl {
+
+/**
+ * A closed interval of mpfr numbers.
+ * All operations round the lower bound down and the upper bound up.
+ * The precision can be changed without releasing the memory of the bounds.
+ */
+class MpfrInterval {
+	mpfr_t m_lower;
+	mpfr_t m_upper;
+public:
+	explicit MpfrInterval(mpfr_prec_t prec) {
+		mpfr_init2(m_lower, prec);
+		mpfr_init2(m_upper, prec);
+		mpfr_set_zero(m_lower, 1);
+		mpfr_set_zero(m_upper, 1);
+	}
+	~MpfrInterval() {
+		mpfr_clear(m_lower);
+		mpfr_clear(m_upper);
+	}
+	MpfrInterval(const MpfrInterval&) = delete;
+	MpfrInterval& operator=(const MpfrInterval&) = delete;
+
+	/**
+	 * Changes the precision and discards the current value.
+	 * The limbs are only reallocated if the precision exceeds the one this interval was created with.
+	 */
+	void set_precision(mpfr_prec_t prec) {
+		mpfr_set_prec(m_lower, prec);
+		mpfr_set_prec(m_upper, prec);
+	}
+	mpfr_prec_t precision() const {
+		return mpfr_get_prec(m_lower);
+	}
+
+	void set(const mpq_class& n) {
+		mpfr_set_q(m_lower, n.get_mpq_t(), MPFR_RNDD);
+		mpfr_set_q(m_upper, n.get_mpq_t(), MPFR_RNDU);
+	}
+	void set(const Interval<mpq_class>& i) {
+		assert(i.lower_bound_type() != BoundType::INFTY && i.upper_bound_type() != BoundType::INFTY);
+		mpfr_set_q(m_lower, i.lower().get_mpq_t(), MPFR_RNDD);
+		mpfr_set_q(m_upper, i.upper().get_mpq_t(), MPFR_RNDU);
+	}
+	void swap(MpfrInterval& i) {
+		mpfr_swap(m_lower, i.m_lower);
+		mpfr_swap(m_upper, i.m_upper);
+	}
+	/// Sets this to a + this.
+	void add_assign(const MpfrInterval& a) {
+		mpfr_add(m_lower, m_lower, a.m_lower, MPFR_RNDD);
+		mpfr_add(m_upper, m_upper, a.m_upper, MPFR_RNDU);
+	}
+	/// Sets this to a + b.
+	void add(const MpfrInterval& a, const MpfrInterval& b) {
+		mpfr_add(m_lower, a.m_lower, b.m_lower, MPFR_RNDD);
+		mpfr_add(m_upper, a.m_upper, b.m_upper, MPFR_RNDU);
+	}
+	/// Sets this to a * b, using tmp as scratch space. This must not alias a or b.
+	void mul(const MpfrInterval& a, const MpfrInterval& b, mpfr_t tmp) {
+		assert(this != &a && this != &b);
+		mpfr_mul(m_lower, a.m_lower, b.m_lower, MPFR_RNDD);
+		mpfr_mul(tmp, a.m_lower, b.m_upper, MPFR_RNDD);
+		mpfr_min(m_lower, m_lower, tmp, MPFR_RNDD);
+		mpfr_mul(tmp, a.m_upper, b.m_lower, MPFR_RNDD);
+		mpfr_min(m_lower, m_lower, tmp, MPFR_RNDD);
+		mpfr_mul(tmp, a.m_upper, b.m_upper, MPFR_RNDD);
+		mpfr_min(m_lower, m_lower, tmp, MPFR_RNDD);
+		mpfr_mul(m_upper, a.m_lower, b.m_lower, MPFR_RNDU);
+		mpfr_mul(tmp, a.m_lower, b.m_upper, MPFR_RNDU);
+		mpfr_max(m_upper, m_upper, tmp, MPFR_RNDU);
+		mpfr_mul(tmp, a.m_upper, b.m_lower, MPFR_RNDU);
+		mpfr_max(m_upper, m_upper, tmp, MPFR_RNDU);
+		mpfr_mul(tmp, a.m_upper, b.m_upper, MPFR_RNDU);
+		mpfr_max(m_upper, m_upper, tmp, MPFR_RNDU);
+	}
+	/// Sets this to a^e. This must not alias a.
+	void pow(const MpfrInterval& a, unsigned long e) {
+		assert(this != &a);
+		if (e % 2 == 1 || mpfr_sgn(a.m_lower) >= 0) {
+			mpfr_pow_ui(m_lower, a.m_lower, e, MPFR_RNDD);
+			mpfr_pow_ui(m_upper, a.m_upper, e, MPFR_RNDU);
+		} else if (mpfr_sgn(a.m_upper) <= 0) {
+			mpfr_pow_ui(m_lower, a.m_upper, e, MPFR_RNDD);
+			mpfr_pow_ui(m_upper, a.m_lower, e, MPFR_RNDU);
+		} else {
+			mpfr_neg(m_lower, a.m_lower, MPFR_RNDU);
+			mpfr_max(m_lower, m_lower, a.m_upper, MPFR_RNDU);
+			mpfr_pow_ui(m_upper, m_lower, e, MPFR_RNDU);
+			mpfr_set_zero(m_lower, 1);
+		}
+	}
+	/// Upper bound on the width of this interval, using tmp as scratch space.
+	double width(mpfr_t tmp) const {
+		mpfr_sub(tmp, m_upper, m_lower, MPFR_RNDU);
+		return mpfr_get_d(tmp, MPFR_RNDU);
+	}
+	std::optional<Sign> sgn() const {
+		if (mpfr_sgn(m_lower) > 0) return Sign::POSITIVE;
+		if (mpfr_sgn(m_upper) < 0) return Sign::NEGATIVE;
+		if (mpfr_zero_p(m_lower) && mpfr_zero_p(m_upper)) return Sign::ZERO;
+		return std::nullopt;
+	}
+};
+
+/**
+ * Determines the sign of a fixed polynomial on rational boxes using MPFR intervals of adaptive precision.
+ *
+ * The polynomial is compiled into an EvaluationPlan once, and every register of the plan is backed by an MpfrInterval.
+ * All intervals are allocated for the maximal precision when the evaluator is created,
+ * hence increasing the precision between iterations (and between queries) never allocates.
+ */
+class AdaptiveMpfrEvaluator {
+	using Plan = EvaluationPlan<mpq_class>;
+	using Op = Plan::Op;
+
+	Plan m_plan;
+	mpfr_prec_t m_initial_precision;
+	mpfr_prec_t m_max_precision;
+	std::deque<MpfrInterval> m_registers;
+	mpfr_t m_scratch;
+	/// Precision used in the last evaluation.
+	mpfr_prec_t m_precision = 0;
+	/// Number of evaluations in the last query.
+	std::size_t m_iterations = 0;
+
+	void set_precision(mpfr_prec_t prec) {
+		for (auto& r: m_registers) r.set_precision(prec);
+		mpfr_set_prec(m_scratch, prec);
+		m_precision = prec;
+	}
+
+	/// Evaluates the plan at the current precision and returns the result register.
+	const MpfrInterval& evaluate(const std::map<Variable, Interval<mpq_class>>& box) {
+		std::size_t reg = 0;
+		for (const auto& c: m_plan.constants()) {
+			m_registers[reg++].set(c);
+		}
+		for (const auto& i: m_plan.instructions()) {
+			MpfrInterval& target = m_registers[reg++];
+			switch (i.op) {
+				case Op::VAR:
+					assert(box.find(m_plan.variables()[i.a]) != box.end());
+					target.set(box.at(m_plan.variables()[i.a]));
+					break;
+				case Op::POW:
+					target.pow(m_registers[i.a], i.exp);
+					break;
+				case Op::MUL:
+					target.mul(m_registers[i.a], m_registers[i.b], m_scratch);
+					break;
+				case Op::ADD:
+					target.add(m_registers[i.a], m_registers[i.b]);
+					break;
+			}
+		}
+		return m_registers[m_plan.result()];
+	}
+
+public:
+	/**
+	 * @param p Polynomial.
+	 * @param initial_precision Precision of the first evaluation in bits.
+	 * @param max_precision Maximal precision in bits.
+	 */
+	explicit AdaptiveMpfrEvaluator(const MultivariatePolynomial<mpq_class>& p, mpfr_prec_t initial_precision = 53, mpfr_prec_t max_precision = 848):
+		m_plan(p),
+		m_initial_precision(initial_precision),
+		m_max_precision(max_precision)
+	{
+		assert(initial_precision >= MPFR_PREC_MIN && initial_precision <= max_precision);
+		for (std::size_t i = 0; i < m_plan.constants().size() + m_plan.instructions().size(); ++i) {
+			m_registers.emplace_back(max_precision);
+		}
+		mpfr_init2(m_scratch, max_precision);
+	}
+	~AdaptiveMpfrEvaluator() {
+		mpfr_clear(m_scratch);
+	}
+	AdaptiveMpfrEvaluator(const AdaptiveMpfrEvaluator&) = delete;
+	AdaptiveMpfrEvaluator& operator=(const AdaptiveMpfrEvaluator&) = delete;
+
+	/**
+	 * Tries to determine the sign of p on the box.
+	 * The precision starts at the initial precision and is doubled until the sign is determined or the maximal precision is exceeded.
+	 * It also stops early if doubling the precision does not halve the width of the result,
+	 * as the width is then dominated by the width of the box instead of rounding errors.
+	 * @param box Bounded intervals for all variables of p.
+	 * @return The sign of p on the box or std::nullopt.
+	 */
+	std::optional<Sign> sgn(const std::map<Variable, Interval<mpq_class>>& box) {
+		m_iterations = 0;
+		for (const auto& v: m_plan.variables()) {
+			const auto& i = box.at(v);
+			if (i.lower_bound_type() == BoundType::INFTY || i.upper_bound_type() == BoundType::INFTY) return std::nullopt;
+		}
+		double last_width = std::numeric_limits<double>::infinity();
+		for (mpfr_prec_t prec = m_initial_precision; prec <= m_max_precision; prec *= 2) {
+			set_precision(prec);
+			++m_iterations;
+			const MpfrInterval& res = evaluate(box);
+			if (auto s = res.sgn(); s) return s;
+			double width = res.width(m_scratch);
+			CARL_LOG_TRACE("carl.signfilter", "MPFR evaluation with " << prec << " bits has width " << width);
+			if (width > last_width / 2) break;
+			last_width = width;
+		}
+		return std::nullopt;
+	}
+
+	/// The precision of the last evaluation.
+	mpfr_prec_t precision() const {
+		return m_precision;
+	}
+	/// The number of evaluations of the last call to sgn().
+	std::size_t iterations() const {
+		return m_iterations;
+	}
+};
+
+}
+
+#endif
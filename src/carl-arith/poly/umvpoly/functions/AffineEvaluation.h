@@ -0,0 +1,221 @@
+#pragma once
+
+/**
+ * @file AffineEvaluation.h
+ * Evaluation of polynomials over boxes with first-order Taylor models.
+ *
+ * Interval evaluation treats every occurrence of a variable independently. For polynomials like x^2 - 2*x*y + y^2 this overestimates the range a lot,
+ * and the overestimation only shrinks linearly with the width of the box.
+ * A first-order Taylor model (or affine form) keeps the linear dependency on every variable symbolically, hence linear parts cancel exactly
+ * and the overestimation shrinks quadratically with the width of the box.
+ */
+
+#include "IntervalEvaluation.h"
+
+#include <carl-arith/interval/Interval.h>
+#include <carl-arith/interval/power.h>
+#include <carl-arith/interval/sampling.h>
+#include <carl-arith/interval/set_theory.h>
+
+#include <map>
+#include <vector>
+
+namespace carl {
+
+/**
+ * An affine form c + a_1 e_1 + ... + a_n e_n + r over noise symbols e_i ranging over [-1,1].
+ *
+ * The center c, the coefficients a_i and the remainder r are intervals, such that rounding errors and all nonlinear parts are enclosed soundly.
+ * The i-th noise symbol stands for the variable in the i-th slot of a box, such that x = mid(X) + rad(X) e_i.
+ */
+template<typename Number>
+class AffineForm {
+	Interval<Number> mCenter;
+	std::vector<Interval<Number>> mCoefficients;
+	Interval<Number> mRemainder;
+
+	/// Encloses a_1 e_1 + ... + a_n e_n + r, i.e. the deviation from the center.
+	Interval<Number> deviation() const {
+		const Interval<Number> unit(-1, 1);
+		Interval<Number> res = mRemainder;
+		for (const auto& a: mCoefficients) {
+			res += a * unit;
+		}
+		return res;
+	}
+	/// Adds factor * (a_1 e_1 + ... + a_n e_n) to the coefficients of this form.
+	void add_scaled(const Interval<Number>& factor, const AffineForm& f) {
+		if (mCoefficients.size() < f.mCoefficients.size()) {
+			mCoefficients.resize(f.mCoefficients.size(), Interval<Number>(0));
+		}
+		for (std::size_t i = 0; i < f.mCoefficients.size(); ++i) {
+			mCoefficients[i] += factor * f.mCoefficients[i];
+		}
+	}
+public:
+	AffineForm():
+		mCenter(0), mRemainder(0)
+	{}
+	/// Creates a constant form.
+	explicit AffineForm(const Interval<Number>& c):
+		mCenter(c), mRemainder(0)
+	{}
+	explicit AffineForm(const Number& c):
+		AffineForm(Interval<Number>(c))
+	{}
+
+	/**
+	 * Creates the form of a variable with the given domain.
+	 * Unbounded domains can not be represented by a noise symbol and are kept in the remainder.
+	 * @param domain Domain of the variable.
+	 * @param symbol Index of the noise symbol of the variable.
+	 */
+	static AffineForm variable(const Interval<Number>& domain, std::size_t symbol) {
+		if (domain.is_empty() || domain.is_unbounded()) {
+			AffineForm res;
+			res.mRemainder = domain;
+			return res;
+		}
+		Number mid = carl::center(domain);
+		Interval<Number> center(mid);
+		// Round the radius up, such that the domain is contained in mid + radius * [-1,1].
+		Number radius = std::max((Interval<Number>(domain.upper()) - center).upper(), (center - Interval<Number>(domain.lower())).upper());
+		AffineForm res(center);
+		res.mCoefficients.resize(symbol + 1, Interval<Number>(0));
+		res.mCoefficients[symbol] = Interval<Number>(radius);
+		return res;
+	}
+
+	const Interval<Number>& center() const {
+		return mCenter;
+	}
+	const std::vector<Interval<Number>>& coefficients() const {
+		return mCoefficients;
+	}
+	const Interval<Number>& remainder() const {
+		return mRemainder;
+	}
+
+	/// Encloses the range of this form.
+	Interval<Number> enclosure() const {
+		return mCenter + deviation();
+	}
+
+	AffineForm& operator+=(const AffineForm& rhs) {
+		mCenter += rhs.mCenter;
+		add_scaled(Interval<Number>(1), rhs);
+		mRemainder += rhs.mRemainder;
+		return *this;
+	}
+
+	friend AffineForm operator+(const AffineForm& lhs, const AffineForm& rhs) {
+		AffineForm res = lhs;
+		res += rhs;
+		return res;
+	}
+
+	/**
+	 * Multiplies two forms.
+	 * (c + d)(c' + d') = cc' + cd' + c'd + dd', where the linear parts of cd' and c'd are kept and dd' is enclosed in the remainder.
+	 */
+	friend AffineForm operator*(const AffineForm& lhs, const AffineForm& rhs) {
+		AffineForm res(lhs.mCenter * rhs.mCenter);
+		res.add_scaled(lhs.mCenter, rhs);
+		res.add_scaled(rhs.mCenter, lhs);
+		res.mRemainder = lhs.mCenter * rhs.mRemainder + rhs.mCenter * lhs.mRemainder + lhs.deviation() * rhs.deviation();
+		return res;
+	}
+
+	/// Squares this form. In contrast to f * f, the nonlinear part is known to be nonnegative.
+	AffineForm square() const {
+		AffineForm res(mCenter * mCenter);
+		res.add_scaled(Interval<Number>(2) * mCenter, *this);
+		res.mRemainder = Interval<Number>(2) * mCenter * mRemainder + carl::pow(deviation(), 2);
+		return res;
+	}
+};
+
+template<typename Number>
+AffineForm<Number> pow(const AffineForm<Number>& f, std::size_t exp) {
+	if (exp == 0) return AffineForm<Number>(Interval<Number>(1));
+	if (exp == 1) return f;
+	AffineForm<Number> half = carl::pow(f, exp / 2).square();
+	if (exp % 2 == 0) return half;
+	return half * f;
+}
+
+template<typename Number>
+std::ostream& operator<<(std::ostream& os, const AffineForm<Number>& f) {
+	os << f.center();
+	for (std::size_t i = 0; i < f.coefficients().size(); ++i) {
+		os << " + " << f.coefficients()[i] << "*e" << i;
+	}
+	return os << " + " << f.remainder();
+}
+
+/**
+ * Selects how a polynomial is evaluated over a box.
+ */
+enum class IntervalEvaluationMode {
+	/// Plain interval arithmetic.
+	INTERVAL,
+	/// First-order Taylor models, intersected with plain interval arithmetic.
+	AFFINE
+};
+
+inline std::ostream& operator<<(std::ostream& os, IntervalEvaluationMode mode) {
+	switch (mode) {
+		case IntervalEvaluationMode::INTERVAL: return os << "interval";
+		case IntervalEvaluationMode::AFFINE: return os << "affine";
+	}
+	return os;
+}
+
+/**
+ * Evaluates p over the box given by map using first-order Taylor models.
+ * This is tighter than interval evaluation for polynomials with many dependent occurrences of the same variable on small boxes,
+ * but may be coarser on wide boxes with high degrees.
+ * @param p Polynomial.
+ * @param map Intervals for all variables of p, either as std::map or as DenseAssignment.
+ * @return An enclosure of the range of p over the box.
+ */
+template<typename Numeric, typename Coeff, typename Policy, typename Ordering, typename Map>
+Interval<Numeric> evaluate_affine(const MultivariatePolynomial<Coeff, Policy, Ordering>& p, const Map& map) {
+	CARL_LOG_FUNC("carl.core.intervalevaluation", p << ", " << map);
+	std::map<Variable, AffineForm<Numeric>> forms;
+	for (auto v: carl::variables(p)) {
+		CARL_LOG_ASSERT("carl.core.intervalevaluation", map.count(v) > (size_t)0, "Every variable is expected to be in the map.");
+		forms.emplace(v, AffineForm<Numeric>::variable(map.at(v), forms.size()));
+	}
+	AffineForm<Numeric> result;
+	for (const auto& t: p) {
+		AffineForm<Numeric> term{Interval<Numeric>(t.coeff())};
+		if (t.monomial()) {
+			for (const auto& [var, exp]: *t.monomial()) {
+				term = term * carl::pow(forms.at(var), exp);
+			}
+		}
+		result += term;
+	}
+	CARL_LOG_TRACE("carl.core.intervalevaluation", "Affine form: " << result);
+	return result.enclosure();
+}
+
+template<typename Coeff, typename Policy, typename Ordering, typename Numeric>
+inline Interval<Numeric> evaluate(const MultivariatePolynomial<Coeff, Policy, Ordering>& p, const std::map<Variable, Interval<Numeric>>& map, IntervalEvaluationMode mode) {
+	Interval<Numeric> res = carl::evaluate(p, map);
+	if (mode == IntervalEvaluationMode::AFFINE && !res.is_empty()) {
+		res = set_intersection(res, evaluate_affine<Numeric>(p, map));
+	}
+	return res;
+}
+template<typename Coeff, typename Policy, typename Ordering, typename Numeric>
+inline Interval<Numeric> evaluate(const MultivariatePolynomial<Coeff, Policy, Ordering>& p, const DenseAssignment<Interval<Numeric>>& map, IntervalEvaluationMode mode) {
+	Interval<Numeric> res = carl::evaluate(p, map);
+	if (mode == IntervalEvaluationMode::AFFINE && !res.is_empty()) {
+		res = set_intersection(res, evaluate_affine<Numeric>(p, map));
+	}
+	return res;
+}
+
+}
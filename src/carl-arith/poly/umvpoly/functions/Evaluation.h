@@ -5,10 +5,14 @@
 #include "../MultivariatePolynomial.h"
 #include "../UnivariatePolynomial.h"
 
+#include <carl-arith/core/DenseAssignment.h>
+
 namespace carl {
 
-template<typename Coefficient>
-Coefficient evaluate(const Monomial& m, const std::map<Variable, Coefficient>& substitutions) {
+namespace detail_evaluation {
+
+template<typename Coefficient, typename Map>
+Coefficient evaluate_monomial(const Monomial& m, const Map& substitutions) {
 	CARL_LOG_FUNC("carl.core.monomial", m << ", " << substitutions);
 	Coefficient res = carl::constant_one<Coefficient>::get();
 	for (const auto& ve : m) {
@@ -20,30 +24,63 @@ Coefficient evaluate(const Monomial& m, const std::map<Variable, Coefficient>& s
 	return res;
 }
 
-template<typename Coefficient>
-Coefficient evaluate(const Term<Coefficient>& t, const std::map<Variable, Coefficient>& map) {
+template<typename Coefficient, typename Map>
+Coefficient evaluate_term(const Term<Coefficient>& t, const Map& map) {
 	if (t.monomial()) {
-		return t.coeff() * evaluate(*t.monomial(), map);
+		return t.coeff() * evaluate_monomial<Coefficient>(*t.monomial(), map);
 	} else {
 		return t.coeff();
 	}
 }
 
-/**
- * Like substitute, but expects substitutions for all variables.
- * @return For a polynomial p, the function value p(x_1,...,x_n).
- */
-template<typename C, typename O, typename P, typename SubstitutionType>
-SubstitutionType evaluate(const MultivariatePolynomial<C,O,P>& p, const std::map<Variable, SubstitutionType>& substitutions) {
+template<typename SubstitutionType, typename C, typename O, typename P, typename Map>
+SubstitutionType evaluate_polynomial(const MultivariatePolynomial<C,O,P>& p, const Map& substitutions) {
 	if(carl::is_zero(p)) {
 		return constant_zero<SubstitutionType>::get();
 	} else {
-		SubstitutionType result(evaluate(p[0], substitutions)); 
+		SubstitutionType result(evaluate(p[0], substitutions));
 		for (unsigned i = 1; i < p.nr_terms(); ++i) {
 			result += evaluate(p[i], substitutions);
 		}
 		return result;
-	};
+	}
+}
+
+}
+
+template<typename Coefficient>
+Coefficient evaluate(const Monomial& m, const std::map<Variable, Coefficient>& substitutions) {
+	return detail_evaluation::evaluate_monomial<Coefficient>(m, substitutions);
+}
+template<typename Coefficient>
+Coefficient evaluate(const Monomial& m, const DenseAssignment<Coefficient>& substitutions) {
+	return detail_evaluation::evaluate_monomial<Coefficient>(m, substitutions);
+}
+
+template<typename Coefficient>
+Coefficient evaluate(const Term<Coefficient>& t, const std::map<Variable, Coefficient>& map) {
+	return detail_evaluation::evaluate_term(t, map);
+}
+template<typename Coefficient>
+Coefficient evaluate(const Term<Coefficient>& t, const DenseAssignment<Coefficient>& map) {
+	return detail_evaluation::evaluate_term(t, map);
+}
+
+/**
+ * Like substitute, but expects substitutions for all variables.
+ * @return For a polynomial p, the function value p(x_1,...,x_n).
+ */
+template<typename C, typename O, typename P, typename SubstitutionType>
+SubstitutionType evaluate(const MultivariatePolynomial<C,O,P>& p, const std::map<Variable, SubstitutionType>& substitutions) {
+	return detail_evaluation::evaluate_polynomial<SubstitutionType>(p, substitutions);
+}
+/**
+ * Like substitute, but expects substitutions for all variables, which are given as a DenseAssignment.
+ * @return For a polynomial p, the function value p(x_1,...,x_n).
+ */
+template<typename C, typename O, typename P, typename SubstitutionType>
+SubstitutionType evaluate(const MultivariatePolynomial<C,O,P>& p, const DenseAssignment<SubstitutionType>& substitutions) {
+	return detail_evaluation::evaluate_polynomial<SubstitutionType>(p, substitutions);
 }
 
 template<typename Coeff>
@@ -0,0 +1,322 @@
+#pragma once
+
+/**
+ * @file EvaluationPlan.h
+ * Compiled evaluation of a fixed polynomial.
+ *
+ * carl::evaluate() walks the terms of a polynomial, looks up every variable occurrence in a map and recomputes every power on each call.
+ * If the same polynomial is evaluated many times (for example during interval constraint propagation), it pays off to compile it once into a flat sequence of instructions.
+ * Variables are assigned to dense slots, powers of a variable and common subexpressions are computed only once, and the plan can be evaluated for any number type T that provides +, * and carl::pow, e.g. double, Interval<double>, mpq_class or Interval<mpq_class>.
+ */
+
+#include "../MultivariatePolynomial.h"
+#include <carl-arith/core/Variable.h>
+#include <carl-arith/interval/Interval.h>
+#include <carl-arith/interval/power.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace carl {
+
+template<typename PolynomialType, class strategy>
+class MultivariateHorner;
+
+template<typename T, typename Coeff>
+class PlanEvaluator;
+
+/**
+ * A polynomial compiled into a flat sequence of instructions over dense variable slots.
+ *
+ * The registers of an evaluation consist of the constants followed by one register per instruction.
+ * Every instruction writes to its own register, operands refer to registers with smaller indices.
+ */
+template<typename Coeff>
+class EvaluationPlan {
+	template<typename T, typename C>
+	friend class PlanEvaluator;
+public:
+	enum class Op : std::uint8_t {
+		/// Loads the value of the variable in slot a.
+		VAR,
+		/// Register a to the power of exp.
+		POW,
+		/// Product of registers a and b.
+		MUL,
+		/// Sum of registers a and b.
+		ADD
+	};
+	struct Instruction {
+		Op op;
+		std::uint32_t a;
+		std::uint32_t b;
+		unsigned exp;
+	};
+private:
+	std::vector<Variable> m_variables;
+	std::vector<Coeff> m_constants;
+	std::vector<Instruction> m_instructions;
+	/// Register holding the result.
+	std::uint32_t m_result = 0;
+
+	// Only needed during compilation.
+	std::map<Coeff, std::uint32_t> m_constant_index;
+	std::map<std::pair<std::size_t, unsigned>, std::uint32_t> m_power_index;
+	std::map<std::tuple<Op, std::uint32_t, std::uint32_t>, std::uint32_t> m_operation_index;
+
+	std::uint32_t constant(const Coeff& c) {
+		auto it = m_constant_index.find(c);
+		if (it != m_constant_index.end()) return it->second;
+		assert(m_instructions.empty());
+		auto res = static_cast<std::uint32_t>(m_constants.size());
+		m_constants.push_back(c);
+		m_constant_index.emplace(c, res);
+		return res;
+	}
+	std::uint32_t emit(Op op, std::uint32_t a, std::uint32_t b = 0, unsigned exp = 0) {
+		m_instructions.push_back(Instruction{op, a, b, exp});
+		return static_cast<std::uint32_t>(m_constants.size() + m_instructions.size() - 1);
+	}
+	/// Register holding v^exp, shared by all occurrences.
+	std::uint32_t power(Variable v, unsigned exp) {
+		std::size_t s = slot(v);
+		auto it = m_power_index.find(std::make_pair(s, exp));
+		if (it != m_power_index.end()) return it->second;
+		std::uint32_t res;
+		if (exp == 1) {
+			res = emit(Op::VAR, static_cast<std::uint32_t>(s));
+		} else {
+			res = emit(Op::POW, power(v, 1), 0, exp);
+		}
+		m_power_index.emplace(std::make_pair(s, exp), res);
+		return res;
+	}
+	/// Register holding a op b. Operations are hash-consed, hence common subexpressions are computed only once.
+	std::uint32_t operation(Op op, std::uint32_t a, std::uint32_t b) {
+		if (b < a) std::swap(a, b);
+		auto key = std::make_tuple(op, a, b);
+		auto it = m_operation_index.find(key);
+		if (it != m_operation_index.end()) return it->second;
+		std::uint32_t res = emit(op, a, b);
+		m_operation_index.emplace(key, res);
+		return res;
+	}
+	std::uint32_t mul(std::uint32_t a, std::uint32_t b) {
+		return operation(Op::MUL, a, b);
+	}
+	std::uint32_t add(std::uint32_t a, std::uint32_t b) {
+		return operation(Op::ADD, a, b);
+	}
+	bool is_constant(std::uint32_t reg, const Coeff& c) const {
+		return reg < m_constants.size() && m_constants[reg] == c;
+	}
+
+	/// Constants have to be registered before any instruction is emitted.
+	template<typename Poly>
+	void collect_constants(const Poly& p) {
+		for (const auto& t: p) constant(t.coeff());
+		constant(Coeff(0));
+	}
+	template<typename Poly, typename Strategy>
+	void collect_constants(const MultivariateHorner<Poly, Strategy>& h) {
+		constant(h.getDepConstant());
+		constant(h.getIndepConstant());
+		if (h.getDependent()) collect_constants(*h.getDependent());
+		if (h.getIndependent()) collect_constants(*h.getIndependent());
+	}
+	template<typename Poly>
+	void collect_variables(const Poly& p, std::vector<Variable>& vars) const {
+		for (const auto& t: p) {
+			if (!t.monomial()) continue;
+			for (const auto& [var, exp]: *t.monomial()) vars.push_back(var);
+		}
+	}
+	template<typename Poly, typename Strategy>
+	void collect_variables(const MultivariateHorner<Poly, Strategy>& h, std::vector<Variable>& vars) const {
+		if (h.getVariable() != Variable::NO_VARIABLE) vars.push_back(h.getVariable());
+		if (h.getDependent()) collect_variables(*h.getDependent(), vars);
+		if (h.getIndependent()) collect_variables(*h.getIndependent(), vars);
+	}
+	void set_variables(std::vector<Variable>&& vars) {
+		std::sort(vars.begin(), vars.end());
+		vars.erase(std::unique(vars.begin(), vars.end()), vars.end());
+		m_variables = std::move(vars);
+	}
+
+	template<typename Poly>
+	std::uint32_t compile(const Poly& p) {
+		std::optional<std::uint32_t> res;
+		for (const auto& t: p) {
+			std::optional<std::uint32_t> term;
+			if (!t.monomial() || !carl::is_one(t.coeff())) term = constant(t.coeff());
+			if (t.monomial()) {
+				for (const auto& [var, exp]: *t.monomial()) {
+					auto pow = power(var, exp);
+					term = term ? mul(*term, pow) : pow;
+				}
+			}
+			res = res ? add(*res, *term) : *term;
+		}
+		return res ? *res : constant(Coeff(0));
+	}
+	template<typename Poly, typename Strategy>
+	std::uint32_t compile(const MultivariateHorner<Poly, Strategy>& h) {
+		if (h.getVariable() == Variable::NO_VARIABLE) {
+			return constant(h.getIndepConstant());
+		}
+		std::uint32_t res = power(h.getVariable(), h.getExponent());
+		std::uint32_t dep = h.getDependent() ? compile(*h.getDependent()) : constant(h.getDepConstant());
+		if (!is_constant(dep, Coeff(1))) res = mul(res, dep);
+		std::uint32_t indep = h.getIndependent() ? compile(*h.getIndependent()) : constant(h.getIndepConstant());
+		if (!is_constant(indep, Coeff(0))) res = add(res, indep);
+		return res;
+	}
+
+	template<typename Source>
+	void build(const Source& source) {
+		std::vector<Variable> vars;
+		collect_variables(source, vars);
+		set_variables(std::move(vars));
+		collect_constants(source);
+		constant(Coeff(1));
+		m_result = compile(source);
+		m_constant_index.clear();
+		m_power_index.clear();
+		m_operation_index.clear();
+	}
+
+public:
+	/**
+	 * Compiles a polynomial.
+	 */
+	template<typename Policy, typename Ordering>
+	explicit EvaluationPlan(const MultivariatePolynomial<Coeff, Policy, Ordering>& p) {
+		build(p);
+	}
+
+	/**
+	 * Compiles a horner scheme. The structure of the scheme is retained.
+	 */
+	template<typename Poly, typename Strategy>
+	explicit EvaluationPlan(const MultivariateHorner<Poly, Strategy>& h) {
+		static_assert(std::is_same<typename Poly::CoeffType, Coeff>::value, "Coefficient types must match");
+		build(h);
+	}
+
+	/// The variables in the order of their slots.
+	const std::vector<Variable>& variables() const {
+		return m_variables;
+	}
+	/// The slot of the given variable, which must occur in the plan.
+	std::size_t slot(Variable v) const {
+		auto it = std::lower_bound(m_variables.begin(), m_variables.end(), v);
+		assert(it != m_variables.end() && *it == v);
+		return static_cast<std::size_t>(std::distance(m_variables.begin(), it));
+	}
+	const std::vector<Coeff>& constants() const {
+		return m_constants;
+	}
+	const std::vector<Instruction>& instructions() const {
+		return m_instructions;
+	}
+	/// The register holding the value of the polynomial.
+	std::uint32_t result() const {
+		return m_result;
+	}
+
+	/**
+	 * Evaluates the plan once. Use a PlanEvaluator for repeated evaluation.
+	 * @param values The values of the variables in the order of variables().
+	 */
+	template<typename T>
+	T evaluate(const std::vector<T>& values) const {
+		PlanEvaluator<T, Coeff> evaluator(*this);
+		return evaluator(values);
+	}
+
+	/**
+	 * Evaluates the plan once, looking up every variable once.
+	 */
+	template<typename T>
+	T evaluate(const std::map<Variable, T>& map) const {
+		PlanEvaluator<T, Coeff> evaluator(*this);
+		return evaluator(map);
+	}
+};
+
+/**
+ * Evaluates an EvaluationPlan for values of type T.
+ * The constants are converted to T once and the registers are reused for all evaluations.
+ */
+template<typename T, typename Coeff>
+class PlanEvaluator {
+	const EvaluationPlan<Coeff>& m_plan;
+	std::vector<T> m_registers;
+	std::vector<T> m_values;
+
+	static T convert(const Coeff& c) {
+		if constexpr (std::is_constructible<T, const Coeff&>::value) {
+			return T(c);
+		} else {
+			return T(carl::to_double(c));
+		}
+	}
+public:
+	explicit PlanEvaluator(const EvaluationPlan<Coeff>& plan):
+		m_plan(plan)
+	{
+		m_registers.reserve(plan.m_constants.size() + plan.m_instructions.size());
+		for (const auto& c: plan.m_constants) {
+			m_registers.emplace_back(convert(c));
+		}
+		m_registers.resize(plan.m_constants.size() + plan.m_instructions.size(), m_registers.front());
+	}
+
+	/**
+	 * Evaluates the plan.
+	 * @param values The values of the variables in the order of EvaluationPlan::variables().
+	 * @return The value of the polynomial, valid until the next evaluation.
+	 */
+	const T& operator()(const std::vector<T>& values) {
+		assert(values.size() == m_plan.m_variables.size());
+		std::size_t reg = m_plan.m_constants.size();
+		for (const auto& i: m_plan.m_instructions) {
+			switch (i.op) {
+				case EvaluationPlan<Coeff>::Op::VAR:
+					m_registers[reg] = values[i.a];
+					break;
+				case EvaluationPlan<Coeff>::Op::POW:
+					m_registers[reg] = carl::pow(m_registers[i.a], i.exp);
+					break;
+				case EvaluationPlan<Coeff>::Op::MUL:
+					m_registers[reg] = m_registers[i.a] * m_registers[i.b];
+					break;
+				case EvaluationPlan<Coeff>::Op::ADD:
+					m_registers[reg] = m_registers[i.a] + m_registers[i.b];
+					break;
+			}
+			++reg;
+		}
+		return m_registers[m_plan.m_result];
+	}
+
+	/**
+	 * Evaluates the plan, looking up every variable of the plan once.
+	 */
+	const T& operator()(const std::map<Variable, T>& map) {
+		m_values.clear();
+		for (const auto& v: m_plan.m_variables) {
+			assert(map.find(v) != map.end());
+			m_values.push_back(map.at(v));
+		}
+		return (*this)(m_values);
+	}
+};
+
+}
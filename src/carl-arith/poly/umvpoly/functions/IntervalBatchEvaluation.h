@@ -0,0 +1,110 @@
+/**
+ * @file IntervalBatchEvaluation.h
+ * Interval evaluation of polynomials on a batch of boxes, see IntervalBatch.
+ *
+ * This is separate from IntervalEvaluation.h, such that only users of batches depend on the SIMD intrinsics and the floating point environment.
+ */
+
+#pragma once
+
+#include <carl-arith/interval/IntervalBatch.h>
+
+#include "../Monomial.h"
+#include "../Term.h"
+#include "../MultivariatePolynomial.h"
+
+#include <map>
+
+namespace carl {
+
+namespace detail_interval_batch {
+/// The size of the batches in the map. If the map is empty, the size can not be determined and has to be given explicitly.
+inline std::size_t batch_size(const std::map<Variable, IntervalBatch<double>>& map) {
+	CARL_LOG_ASSERT("carl.core.intervalevaluation", !map.empty(), "The size of the batch is given by the map, which must not be empty.");
+	return map.empty() ? 0 : map.begin()->second.size();
+}
+}
+
+/**
+ * Evaluates a monomial on a batch of boxes.
+ * All batches in the map have to be of the same size as result.
+ * @param m Monomial.
+ * @param map Batches of intervals for the variables.
+ * @param result Is multiplied by the value of m.
+ * @param scratch Scratch space.
+ */
+inline void evaluate(const Monomial& m, const std::map<Variable, IntervalBatch<double>>& map, IntervalBatch<double>& result, IntervalBatch<double>& scratch)
+{
+	for (const auto& [var, exp]: m) {
+		CARL_LOG_ASSERT("carl.core.intervalevaluation", map.count(var) > (size_t)0, "Every variable is expected to be in the map.");
+		CARL_LOG_ASSERT("carl.core.intervalevaluation", map.at(var).size() == result.size(), "All batches are expected to be of the same size.");
+		pow(map.at(var), exp, scratch);
+		mul(result, scratch, result);
+	}
+}
+
+inline IntervalBatch<double> evaluate(const Monomial& m, const std::map<Variable, IntervalBatch<double>>& map)
+{
+	IntervalBatch<double> result(detail_interval_batch::batch_size(map), Interval<double>(1));
+	IntervalBatch<double> scratch;
+	evaluate(m, map, result, scratch);
+	return result;
+}
+
+/**
+ * Evaluates a term on a batch of the given size.
+ * All batches in the map have to be of this size, the map may be empty if the term is constant.
+ */
+template<typename Coeff>
+inline IntervalBatch<double> evaluate(const Term<Coeff>& t, const std::map<Variable, IntervalBatch<double>>& map, std::size_t size)
+{
+	IntervalBatch<double> result(size, Interval<double>(t.coeff()));
+	if (t.monomial()) {
+		IntervalBatch<double> scratch;
+		evaluate(*t.monomial(), map, result, scratch);
+	}
+	return result;
+}
+
+/**
+ * Evaluates a term on a batch of boxes, whose size is given by the batches in the map.
+ * The map must not be empty.
+ */
+template<typename Coeff>
+inline IntervalBatch<double> evaluate(const Term<Coeff>& t, const std::map<Variable, IntervalBatch<double>>& map)
+{
+	return evaluate(t, map, detail_interval_batch::batch_size(map));
+}
+
+/**
+ * Evaluates a polynomial on a batch of the given size, see IntervalBatch.
+ * All batches in the map have to be of this size, the map may be empty if the polynomial is constant.
+ */
+template<typename Coeff, typename Policy, typename Ordering>
+inline IntervalBatch<double> evaluate(const MultivariatePolynomial<Coeff, Policy, Ordering>& p, const std::map<Variable, IntervalBatch<double>>& map, std::size_t size)
+{
+	CARL_LOG_FUNC("carl.core.intervalevaluation", p << ", " << map);
+	IntervalBatch<double> result(size, Interval<double>(0));
+	IntervalBatch<double> term(size);
+	IntervalBatch<double> scratch(size);
+	for (const auto& t: p) {
+		term.fill(Interval<double>(t.coeff()));
+		if (t.monomial()) {
+			evaluate(*t.monomial(), map, term, scratch);
+		}
+		add(result, term, result);
+	}
+	return result;
+}
+
+/**
+ * Evaluates a polynomial on a batch of boxes, whose size is given by the batches in the map.
+ * The map must not be empty, use the overload taking the size otherwise.
+ */
+template<typename Coeff, typename Policy, typename Ordering>
+inline IntervalBatch<double> evaluate(const MultivariatePolynomial<Coeff, Policy, Ordering>& p, const std::map<Variable, IntervalBatch<double>>& map)
+{
+	return evaluate(p, map, detail_interval_batch::batch_size(map));
+}
+
+}
@@ -1,6 +1,8 @@
 #pragma once
 #include <carl-arith/interval/Interval.h>
 #include <carl-arith/interval/power.h>
+#include <carl-arith/interval/inplace.h>
+#include <carl-arith/core/DenseAssignment.h>
 
 #include "../Monomial.h"
 #include "../Term.h"
@@ -8,58 +10,119 @@
 
 namespace carl {
 
-template<typename Numeric>
-inline Interval<Numeric> evaluate(const Monomial& m, const std::map<Variable, Interval<Numeric>>& map)
+namespace detail_interval_evaluation {
+
+/**
+ * Multiplies result by the value of m, using factor as scratch space.
+ */
+template<typename Numeric, typename Map>
+inline void evaluate_monomial(const Monomial& m, const Map& map, Interval<Numeric>& result, Interval<Numeric>& factor)
 {
-	Interval<Numeric> result(1);
 	CARL_LOG_TRACE("carl.core.intervalevaluation", "Iterating over " << m);
 	for(unsigned i = 0; i < m.num_variables(); ++i)
 	{
 		CARL_LOG_TRACE("carl.core.intervalevaluation", "Iterating: " << m[i].first);
 		// We expect every variable to be in the map.
 		CARL_LOG_ASSERT("carl.core.intervalevaluation", map.count(m[i].first) > (size_t)0, "Every variable is expected to be in the map.");
-		result *= carl::pow(map.at(m[i].first), m[i].second);
-        if( result.is_zero() )
-            return result;
+		carl::pow(map.at(m[i].first), m[i].second, factor);
+		carl::mul(result, factor, result);
+		if( result.is_zero() )
+			return;
 	}
-	return result;
 }
 
-template<typename Coeff, typename Numeric, EnableIf<std::is_same<Numeric, Coeff>> = dummy>
-inline Interval<Numeric> evaluate(const Term<Coeff>& t, const std::map<Variable, Interval<Numeric>>& map)
+template<typename Numeric, typename Map>
+inline Interval<Numeric> evaluate_monomial(const Monomial& m, const Map& map)
 {
-	Interval<Numeric> result(t.coeff());
-	if (t.monomial())
-		result *= evaluate( *t.monomial(), map );
+	Interval<Numeric> result(1);
+	Interval<Numeric> factor;
+	evaluate_monomial(m, map, result, factor);
 	return result;
 }
 
-template<typename Coeff, typename Numeric, DisableIf<std::is_same<Numeric, Coeff>> = dummy>
-inline Interval<Numeric> evaluate(const Term<Coeff>& t, const std::map<Variable, Interval<Numeric>>& map)
+/**
+ * Stores the value of t in result, using factor as scratch space.
+ */
+template<typename Numeric, typename Coeff, typename Map>
+inline void evaluate_term(const Term<Coeff>& t, const Map& map, Interval<Numeric>& result, Interval<Numeric>& factor)
 {
-	Interval<Numeric> result(t.coeff());
+	if constexpr (std::is_same<Numeric, Coeff>::value) {
+		carl::assign(t.coeff(), result);
+	} else {
+		result = Interval<Numeric>(t.coeff());
+	}
 	if (t.monomial())
-		result *= evaluate( *t.monomial(), map );
+		evaluate_monomial(*t.monomial(), map, result, factor);
+}
+
+template<typename Numeric, typename Coeff, typename Map>
+inline Interval<Numeric> evaluate_term(const Term<Coeff>& t, const Map& map)
+{
+	Interval<Numeric> result;
+	Interval<Numeric> factor;
+	evaluate_term(t, map, result, factor);
 	return result;
 }
 
-template<typename Coeff, typename Policy, typename Ordering, typename Numeric>
-inline Interval<Numeric> evaluate(const MultivariatePolynomial<Coeff, Policy, Ordering>& p, const std::map<Variable, Interval<Numeric>>& map)
+/**
+ * Evaluates p using in-place interval operations, such that all terms share the same scratch intervals.
+ */
+template<typename Numeric, typename Coeff, typename Policy, typename Ordering, typename Map>
+inline Interval<Numeric> evaluate_polynomial(const MultivariatePolynomial<Coeff, Policy, Ordering>& p, const Map& map)
 {
 	CARL_LOG_FUNC("carl.core.intervalevaluation", p << ", " << map);
 	if(is_zero(p)) {
 		return Interval<Numeric>(0);
 	} else {
-		Interval<Numeric> result(evaluate(p[0], map)); 
+		Interval<Numeric> result;
+		Interval<Numeric> term;
+		Interval<Numeric> factor;
+		evaluate_term(p[0], map, result, factor);
 		for (unsigned i = 1; i < p.nr_terms(); ++i) {
-            if( result.is_infinite() )
-                return result;
-			result += evaluate(p[i], map);
+			if( result.is_infinite() )
+				return result;
+			evaluate_term(p[i], map, term, factor);
+			carl::add(result, term, result);
 		}
 		return result;
 	}
 }
 
+}
+
+template<typename Numeric>
+inline Interval<Numeric> evaluate(const Monomial& m, const std::map<Variable, Interval<Numeric>>& map)
+{
+	return detail_interval_evaluation::evaluate_monomial<Numeric>(m, map);
+}
+template<typename Numeric>
+inline Interval<Numeric> evaluate(const Monomial& m, const DenseAssignment<Interval<Numeric>>& map)
+{
+	return detail_interval_evaluation::evaluate_monomial<Numeric>(m, map);
+}
+
+template<typename Coeff, typename Numeric>
+inline Interval<Numeric> evaluate(const Term<Coeff>& t, const std::map<Variable, Interval<Numeric>>& map)
+{
+	return detail_interval_evaluation::evaluate_term<Numeric>(t, map);
+}
+template<typename Coeff, typename Numeric>
+inline Interval<Numeric> evaluate(const Term<Coeff>& t, const DenseAssignment<Interval<Numeric>>& map)
+{
+	return detail_interval_evaluation::evaluate_term<Numeric>(t, map);
+}
+
+template<typename Coeff, typename Policy, typename Ordering, typename Numeric>
+inline Interval<Numeric> evaluate(const MultivariatePolynomial<Coeff, Policy, Ordering>& p, const std::map<Variable, Interval<Numeric>>& map)
+{
+	return detail_interval_evaluation::evaluate_polynomial<Numeric>(p, map);
+}
+template<typename Coeff, typename Policy, typename Ordering, typename Numeric>
+inline Interval<Numeric> evaluate(const MultivariatePolynomial<Coeff, Policy, Ordering>& p, const DenseAssignment<Interval<Numeric>>& map)
+{
+	return detail_interval_evaluation::evaluate_polynomial<Numeric>(p, map);
+}
+
 template<typename Numeric, typename Coeff, EnableIf<std::is_same<Numeric, Coeff>> = dummy>
 inline Interval<Numeric> evaluate(const UnivariatePolynomial<Coeff>& p, const std::map<Variable, Interval<Numeric>>& map) {
 	CARL_LOG_FUNC("carl.core.intervalevaluation", p << ", " << map);
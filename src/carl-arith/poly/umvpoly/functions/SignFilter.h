@@ -0,0 +1,122 @@
+#pragma once
+
+/**
+ * @file SignFilter.h
+ * Floating point filter for sign queries of polynomials.
+ *
+ * Most sign queries are far from zero and can be decided by an interval evaluation in floating point arithmetic.
+ * We first evaluate with Interval<double> (whose bounds are rounded outwards) and, if MPFR is available, continue with MPFR intervals at increasing precision.
+ * Only if no floating point stage decides the sign, the caller has to fall back to exact arithmetic.
+ * The number of queries decided by each stage and the number of undecided queries are recorded in sign_filter::statistics().
+ */
+
+#include "AdaptiveEvaluation.h"
+#include "IntervalEvaluation.h"
+#include "SignFilterStatistics.h"
+
+#include <carl-arith/core/Sign.h>
+
+#include <optional>
+#ifdef USE_MPFR_FLOAT
+#include <memory>
+#include <unordered_map>
+#endif
+
+namespace carl {
+
+namespace detail_sign_filter {
+
+template<typename Number>
+std::optional<Sign> sgn(const Interval<Number>& i) {
+	if (i.is_zero()) return Sign::ZERO;
+	if (i.is_positive()) return Sign::POSITIVE;
+	if (i.is_negative()) return Sign::NEGATIVE;
+	return std::nullopt;
+}
+
+template<typename Number>
+std::optional<Sign> sgn_double(const MultivariatePolynomial<Number>& p, const std::map<Variable, Interval<Number>>& box) {
+	std::map<Variable, Interval<double>> double_box;
+	for (const auto& [var, i] : box) {
+		double_box.emplace(var, Interval<double>(i.lower(), i.lower_bound_type(), i.upper(), i.upper_bound_type()));
+	}
+	Interval<double> res = carl::evaluate(p, double_box);
+	CARL_LOG_TRACE("carl.signfilter", "Double evaluation of " << p << " on " << double_box << " -> " << res);
+	return sgn(res);
+}
+
+#ifdef USE_MPFR_FLOAT
+/// Maximal number of MPFR evaluators kept by every thread.
+constexpr std::size_t max_cached_evaluators = 1024;
+
+/**
+ * Returns an MPFR evaluator for p, starting at 106 bits as the double stage already covers 53 bits.
+ * Compiling the plan and allocating the registers is far more expensive than a single query, hence evaluators are cached per polynomial.
+ * Evaluators are modified by every query, so every thread has its own cache. It is cleared once it holds max_cached_evaluators entries.
+ */
+inline AdaptiveMpfrEvaluator& mpfr_evaluator(const MultivariatePolynomial<mpq_class>& p) {
+	static thread_local std::unordered_map<MultivariatePolynomial<mpq_class>, std::unique_ptr<AdaptiveMpfrEvaluator>> cache;
+	auto it = cache.find(p);
+	if (it == cache.end()) {
+		if (cache.size() >= max_cached_evaluators) cache.clear();
+		it = cache.emplace(p, std::make_unique<AdaptiveMpfrEvaluator>(p, 106)).first;
+	}
+	return *it->second;
+}
+
+inline std::optional<Sign> sgn_mpfr(AdaptiveMpfrEvaluator& evaluator, const std::map<Variable, Interval<mpq_class>>& box) {
+	auto res = evaluator.sgn(box);
+	if (res) {
+		CARL_CALL_STATISTICS(sign_filter::statistics().decided_mpfr++);
+	} else {
+		CARL_CALL_STATISTICS(sign_filter::statistics().undecided++);
+	}
+	return res;
+}
+#endif
+
+}
+
+/**
+ * Tries to determine the sign of p on the whole given box using floating point interval arithmetic.
+ * The box has to assign an interval to every variable of p.
+ * @param p Polynomial.
+ * @param box Intervals for the variables of p.
+ * @return The sign of p on the box or std::nullopt if the floating point evaluation was not precise enough.
+ */
+template<typename Number>
+std::optional<Sign> filtered_sgn(const MultivariatePolynomial<Number>& p, const std::map<Variable, Interval<Number>>& box) {
+	CARL_LOG_FUNC("carl.signfilter", p << ", " << box);
+	if (auto res = detail_sign_filter::sgn_double(p, box); res) {
+		CARL_CALL_STATISTICS(sign_filter::statistics().decided_double++);
+		return res;
+	}
+	#ifdef USE_MPFR_FLOAT
+	if constexpr (std::is_same<Number, mpq_class>::value) {
+		return detail_sign_filter::sgn_mpfr(detail_sign_filter::mpfr_evaluator(p), box);
+	}
+	#endif
+	CARL_CALL_STATISTICS(sign_filter::statistics().undecided++);
+	return std::nullopt;
+}
+
+#ifdef USE_MPFR_FLOAT
+/**
+ * Tries to determine the sign of p on the whole given box like filtered_sgn(p, box), using the given MPFR evaluator for p.
+ * This avoids looking up the evaluator if the caller already holds one.
+ * @param p Polynomial.
+ * @param box Intervals for the variables of p.
+ * @param evaluator Evaluator for p.
+ * @return The sign of p on the box or std::nullopt if the floating point evaluation was not precise enough.
+ */
+inline std::optional<Sign> filtered_sgn(const MultivariatePolynomial<mpq_class>& p, const std::map<Variable, Interval<mpq_class>>& box, AdaptiveMpfrEvaluator& evaluator) {
+	CARL_LOG_FUNC("carl.signfilter", p << ", " << box);
+	if (auto res = detail_sign_filter::sgn_double(p, box); res) {
+		CARL_CALL_STATISTICS(sign_filter::statistics().decided_double++);
+		return res;
+	}
+	return detail_sign_filter::sgn_mpfr(evaluator, box);
+}
+#endif
+
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <carl-statistics/carl-statistics.h>
+
+#ifdef CARL_DEVOPTION_Statistics
+
+namespace carl {
+namespace sign_filter {
+
+class SignFilterStatistics : public statistics::Statistics {
+public:
+	/// Number of sign queries decided by double interval evaluation.
+	std::size_t decided_double = 0;
+	/// Number of sign queries decided by MPFR interval evaluation.
+	std::size_t decided_mpfr = 0;
+	/// Number of sign queries that no floating point stage could decide and are left to exact arithmetic.
+	std::size_t undecided = 0;
+	void collect() {
+		Statistics::addKeyValuePair("decided_double", decided_double);
+		Statistics::addKeyValuePair("decided_mpfr", decided_mpfr);
+		Statistics::addKeyValuePair("undecided", undecided);
+	}
+};
+
+static auto& statistics() {
+	static CARL_INIT_STATISTICS(SignFilterStatistics, stats, "sign_filter");
+	return stats;
+}
+
+}
+}
+#endif
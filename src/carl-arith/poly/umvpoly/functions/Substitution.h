@@ -6,6 +6,8 @@
 
 #include "../Monomial.h"
 
+#include <carl-arith/core/DenseAssignment.h>
+
 namespace carl {
 
 /**
@@ -31,8 +33,10 @@ Coeff substitute(const Monomial& m, const std::map<Variable, Coeff>& substitutio
 	return res;
 }
 
-template<typename Coeff>
-Term<Coeff> substitute(const Term<Coeff>& t, const std::map<Variable, Coeff>& substitutions) {
+namespace detail_substitution {
+
+template<typename Coeff, typename Map>
+Term<Coeff> substitute_term(const Term<Coeff>& t, const Map& substitutions) {
 	if (t.monomial()) {
 		Monomial::Content content;
 		Coeff coeff = t.coeff();
@@ -51,6 +55,36 @@ Term<Coeff> substitute(const Term<Coeff>& t, const std::map<Variable, Coeff>& su
 	}
 }
 
+template<typename C, typename O, typename P, typename Map>
+MultivariatePolynomial<C,O,P> substitute_polynomial(const MultivariatePolynomial<C,O,P>& p, const Map& substitutions) {
+	MultivariatePolynomial<C,O,P> result;
+	auto& tam = MultivariatePolynomial<C,O,P>::mTermAdditionManager;
+	auto id = tam.getId(p.nr_terms());
+	for (const auto& term: p) {
+		Term<C> resultTerm = substitute(term, substitutions);
+		if( !carl::is_zero(resultTerm) )
+		{
+			tam.template addTerm<false>(id, resultTerm );
+		}
+	}
+	tam.readTerms(id, result.terms());
+	result.reset_ordered();
+	result.template makeMinimallyOrdered<false, true>();
+	assert(result.is_consistent());
+	return result;
+}
+
+}
+
+template<typename Coeff>
+Term<Coeff> substitute(const Term<Coeff>& t, const std::map<Variable, Coeff>& substitutions) {
+	return detail_substitution::substitute_term(t, substitutions);
+}
+template<typename Coeff>
+Term<Coeff> substitute(const Term<Coeff>& t, const DenseAssignment<Coeff>& substitutions) {
+	return detail_substitution::substitute_term(t, substitutions);
+}
+
 template<typename Coeff>
 Term<Coeff> substitute(const Term<Coeff>& t, const std::map<Variable, Term<Coeff>>& substitutions) {
 	if (t.monomial()) {
@@ -192,21 +226,15 @@ MultivariatePolynomial<C,O,P> substitute(const MultivariatePolynomial<C,O,P>& p,
 template<typename C, typename O, typename P, typename S>
 MultivariatePolynomial<C,O,P> substitute(const MultivariatePolynomial<C,O,P>& p, const std::map<Variable,S>& substitutions) {
 	static_assert(!std::is_same<S, Term<C>>::value, "Terms are handled by a separate method.");
-	MultivariatePolynomial<C,O,P> result;
-	auto& tam = MultivariatePolynomial<C,O,P>::mTermAdditionManager;
-	auto id = tam.getId(p.nr_terms());
-	for (const auto& term: p) {
-		Term<C> resultTerm = substitute(term, substitutions);
-		if( !carl::is_zero(resultTerm) )
-		{
-			tam.template addTerm<false>(id, resultTerm );
-		}
-	}
-	tam.readTerms(id, result.terms());
-	result.reset_ordered();
-	result.template makeMinimallyOrdered<false, true>();
-	assert(result.is_consistent());
-	return result;
+	return detail_substitution::substitute_polynomial(p, substitutions);
+}
+
+/**
+ * Substitutes the variables assigned in a DenseAssignment.
+ */
+template<typename C, typename O, typename P>
+MultivariatePolynomial<C,O,P> substitute(const MultivariatePolynomial<C,O,P>& p, const DenseAssignment<C>& substitutions) {
+	return detail_substitution::substitute_polynomial(p, substitutions);
 }
 
 template<typename C, typename O, typename P>
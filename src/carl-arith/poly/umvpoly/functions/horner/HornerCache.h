@@ -0,0 +1,175 @@
+/**
+ * @file HornerCache.h
+ * Global cache of compiled horner schemes.
+ */
+
+#pragma once
+
+#include "HornerCacheStatistics.h"
+#include "MultivariateHorner.h"
+#include "../EvaluationPlan.h"
+
+#include <carl-arith/interval/Interval.h>
+#include <carl-common/memory/Singleton.h>
+
+#include <algorithm>
+#include <cassert>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#ifdef THREAD_SAFE
+#include <mutex>
+#endif
+
+namespace carl {
+
+/**
+ * Caches a horner scheme for every polynomial, compiled into an EvaluationPlan.
+ *
+ * A MultivariateHorner is a tree of shared pointers that is rebuilt whenever some object needs the horner scheme of a polynomial.
+ * The cache builds the scheme only once per polynomial and stores it as a plan, i.e. as a flat array of instructions in which
+ * powers and common subexpressions are shared. All users of the same polynomial share the same immutable plan.
+ *
+ * Which variable selection heuristic yields the better scheme depends on the polynomial.
+ * Hence both a GREEDY_I and a GREEDY_II scheme are built and the one with the smaller estimated cost of an interval evaluation is kept.
+ * The cost is estimated from the operations of the plan instead of measuring evaluation times, such that the selected scheme
+ * (and hence every enclosure computed with it) does not depend on the machine or its load. If both are equally expensive, GREEDY_I is used.
+ *
+ * The cache holds at most capacity() polynomials and is cleared once it is full, like the evaluator cache of the sign filter.
+ * As plans are shared, clearing the cache does not invalidate plans that are still in use.
+ */
+template<typename Poly>
+class HornerCache : public Singleton<HornerCache<Poly>> {
+	friend Singleton<HornerCache<Poly>>;
+public:
+	using Coeff = typename Poly::CoeffType;
+	using Plan = EvaluationPlan<Coeff>;
+
+	/// Default for the maximal number of cached polynomials.
+	static constexpr std::size_t default_capacity = 1 << 16;
+
+	struct Entry {
+		std::shared_ptr<const Plan> plan;
+		/// The heuristic used to build the scheme.
+		variableSelectionHeurisics selection;
+		/// Estimated cost of a single interval evaluation, see cost().
+		std::size_t cost;
+	};
+private:
+	struct GreedyI : public strategy {
+		static CONSTEXPR variableSelectionHeurisics selectionType = GREEDY_I;
+	};
+	struct GreedyII : public strategy {
+		static CONSTEXPR variableSelectionHeurisics selectionType = GREEDY_II;
+	};
+
+	std::unordered_map<Poly, Entry> mEntries;
+	std::size_t mCapacity = default_capacity;
+#ifdef THREAD_SAFE
+	std::mutex mMutex;
+#endif
+
+	HornerCache() = default;
+
+	Entry compute(const Poly& p) const {
+		auto greedyI = std::make_shared<const Plan>(MultivariateHorner<Poly, GreedyI>(p));
+		auto greedyII = std::make_shared<const Plan>(MultivariateHorner<Poly, GreedyII>(p));
+		std::size_t costI = cost(*greedyI);
+		std::size_t costII = cost(*greedyII);
+		CARL_LOG_DEBUG("carl.horner", "Horner schemes of " << p << ": GREEDY_I costs " << costI << ", GREEDY_II costs " << costII);
+		if (costII < costI) {
+			CARL_CALL_STATISTICS(horner_cache::statistics().selected_greedy_ii++);
+			return Entry{greedyII, GREEDY_II, costII};
+		}
+		CARL_CALL_STATISTICS(horner_cache::statistics().selected_greedy_i++);
+		return Entry{greedyI, GREEDY_I, costI};
+	}
+
+public:
+	/**
+	 * Returns the cached horner scheme of p, building it if necessary.
+	 */
+	Entry get(const Poly& p) {
+#ifdef THREAD_SAFE
+		std::lock_guard<std::mutex> lock(mMutex);
+#endif
+		auto it = mEntries.find(p);
+		if (it != mEntries.end()) {
+			CARL_CALL_STATISTICS(horner_cache::statistics().hits++);
+			return it->second;
+		}
+		CARL_CALL_STATISTICS(horner_cache::statistics().misses++);
+		CARL_TIME_START(start);
+		Entry res = compute(p);
+		CARL_TIME_FINISH(horner_cache::statistics().construction, start);
+		if (mEntries.size() >= mCapacity) {
+			CARL_LOG_DEBUG("carl.horner", "Horner cache holds " << mEntries.size() << " schemes, clearing it");
+			mEntries.clear();
+		}
+		mEntries.emplace(p, res);
+		return res;
+	}
+
+	/**
+	 * Returns the compiled horner scheme of p.
+	 */
+	std::shared_ptr<const Plan> plan(const Poly& p) {
+		return get(p).plan;
+	}
+
+	/**
+	 * Estimates the cost of an interval evaluation of the given plan.
+	 * An interval multiplication costs four multiplications of the bounds, an addition two additions.
+	 * A power is computed by repeated squaring, i.e. it costs about one multiplication per bit of the exponent.
+	 */
+	static std::size_t cost(const Plan& plan) {
+		std::size_t res = 0;
+		for (const auto& instr: plan.instructions()) {
+			switch (instr.op) {
+				case Plan::Op::VAR: break;
+				case Plan::Op::POW: {
+					std::size_t bits = 0;
+					for (unsigned e = instr.exp; e > 1; e /= 2) ++bits;
+					res += 4 * std::max<std::size_t>(bits, 1);
+					break;
+				}
+				case Plan::Op::MUL: res += 4; break;
+				case Plan::Op::ADD: res += 2; break;
+			}
+		}
+		return res;
+	}
+
+	std::size_t size() {
+#ifdef THREAD_SAFE
+		std::lock_guard<std::mutex> lock(mMutex);
+#endif
+		return mEntries.size();
+	}
+
+	std::size_t capacity() {
+#ifdef THREAD_SAFE
+		std::lock_guard<std::mutex> lock(mMutex);
+#endif
+		return mCapacity;
+	}
+
+	/// Sets the maximal number of cached polynomials, which must be positive. Takes effect when the next scheme is built.
+	void set_capacity(std::size_t capacity) {
+		assert(capacity > 0);
+#ifdef THREAD_SAFE
+		std::lock_guard<std::mutex> lock(mMutex);
+#endif
+		mCapacity = capacity;
+	}
+
+	/// Removes all cached schemes. Plans that are still in use stay valid.
+	void clear() {
+#ifdef THREAD_SAFE
+		std::lock_guard<std::mutex> lock(mMutex);
+#endif
+		mEntries.clear();
+	}
+};
+
+}
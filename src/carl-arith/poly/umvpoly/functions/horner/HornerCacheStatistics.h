@@ -0,0 +1,38 @@
+#pragma once
+
+#include <carl-statistics/carl-statistics.h>
+
+#ifdef CARL_DEVOPTION_Statistics
+
+namespace carl {
+namespace horner_cache {
+
+class HornerCacheStatistics : public statistics::Statistics {
+public:
+	/// Time spent building horner schemes and estimating their costs.
+	statistics::timer construction;
+	/// Number of requests answered from the cache.
+	std::size_t hits = 0;
+	/// Number of requests that had to build a horner scheme.
+	std::size_t misses = 0;
+	/// Number of polynomials for which GREEDY_I was selected.
+	std::size_t selected_greedy_i = 0;
+	/// Number of polynomials for which GREEDY_II was selected.
+	std::size_t selected_greedy_ii = 0;
+	void collect() {
+		Statistics::addKeyValuePair("construction", construction);
+		Statistics::addKeyValuePair("hits", hits);
+		Statistics::addKeyValuePair("misses", misses);
+		Statistics::addKeyValuePair("selected_greedy_i", selected_greedy_i);
+		Statistics::addKeyValuePair("selected_greedy_ii", selected_greedy_ii);
+	}
+};
+
+static auto& statistics() {
+	static CARL_INIT_STATISTICS(HornerCacheStatistics, stats, "horner_cache");
+	return stats;
+}
+
+}
+}
+#endif
@@ -11,8 +11,10 @@ namespace carl {
 template<typename PolynomialType, class strategy  >
 class MultivariateHorner; 
 
-template<typename PolynomialType, typename Number, class strategy>
-inline Interval<Number> evaluate(const MultivariateHorner<PolynomialType, strategy>& mvH, const std::map<Variable, Interval<Number>>& map)
+namespace detail_interval_evaluation {
+
+template<typename PolynomialType, typename Number, class strategy, typename Map>
+inline Interval<Number> evaluate_horner(const MultivariateHorner<PolynomialType, strategy>& mvH, const Map& map)
 {
 	Interval<Number> result(1);
 	CARL_LOG_FUNC("carl.core.intervalevaluation", mvH << ", " << map);
@@ -31,19 +33,19 @@ inline Interval<Number> evaluate(const MultivariateHorner<PolynomialType, strate
 		//Case 2: dependent part contains a Horner Scheme
 		else if (mvH.getDependent() && !mvH.getIndependent())
 		{
-			result = pow(varValue, mvH.getExponent()) * evaluate(*mvH.getDependent(), map) + Interval<Number> (mvH.getIndepConstant());
+			result = pow(varValue, mvH.getExponent()) * evaluate_horner<PolynomialType, Number>(*mvH.getDependent(), map) + Interval<Number> (mvH.getIndepConstant());
 			return result;
 		}
 		//Case 3: independent part contains a Horner Scheme
 		else if (!mvH.getDependent() && mvH.getIndependent())
 		{
-			result = pow(varValue, mvH.getExponent()) * Interval<Number> (mvH.getDepConstant()) +  evaluate(*mvH.getIndependent(), map);
+			result = pow(varValue, mvH.getExponent()) * Interval<Number> (mvH.getDepConstant()) +  evaluate_horner<PolynomialType, Number>(*mvH.getIndependent(), map);
 			return result;
 		}
 		//Case 4: both independent part and dependent part 
 		else if (mvH.getDependent()  && mvH.getIndependent())
 		{
-			result = pow(varValue, mvH.getExponent()) * evaluate(*mvH.getDependent(), map) + evaluate(*mvH.getIndependent(), map);
+			result = pow(varValue, mvH.getExponent()) * evaluate_horner<PolynomialType, Number>(*mvH.getDependent(), map) + evaluate_horner<PolynomialType, Number>(*mvH.getIndependent(), map);
 			return result;
 		}
 	}
@@ -54,6 +56,18 @@ inline Interval<Number> evaluate(const MultivariateHorner<PolynomialType, strate
 	return result;
 }
 
+}
+
+template<typename PolynomialType, typename Number, class strategy>
+inline Interval<Number> evaluate(const MultivariateHorner<PolynomialType, strategy>& mvH, const std::map<Variable, Interval<Number>>& map)
+{
+	return detail_interval_evaluation::evaluate_horner<PolynomialType, Number>(mvH, map);
+}
 
+template<typename PolynomialType, typename Number, class strategy>
+inline Interval<Number> evaluate(const MultivariateHorner<PolynomialType, strategy>& mvH, const DenseAssignment<Interval<Number>>& map)
+{
+	return detail_interval_evaluation::evaluate_horner<PolynomialType, Number>(mvH, map);
+}
 
 } //Namespace carl
@@ -11,6 +11,7 @@
 #include "../../MultivariatePolynomial.h"
 #include <carl-arith/interval/Interval.h>
 #include "IntervalEvaluation.h"
+#include "../Division.h"
 #include "MultivariateHornerSettings.h"
 
 #include "../../Term.h"
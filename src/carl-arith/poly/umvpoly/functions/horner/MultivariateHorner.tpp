@@ -151,9 +151,9 @@ namespace carl
 						if (polynomialIt->has(*variableIt))
 						{
 							Term< typename PolynomialType::CoeffType > currentTerm = *polynomialIt;
-							Term< typename PolynomialType::CoeffType > currentTerm_div = *polynomialIt;
+							Term< typename PolynomialType::CoeffType > currentTerm_div;
 
-							currentTerm_div.divide(*variableIt, currentTerm_div);
+							carl::try_divide(*polynomialIt, *variableIt, currentTerm_div);
 
 							currentInterval = carl::evaluate( currentTerm_div, map );
 
@@ -205,7 +205,7 @@ namespace carl
 				{
 					//divide dependent terms by choosen Variable
 
-					polynomialIt->divide(*selectedVariable, tempTerm);
+					carl::try_divide(*polynomialIt, *selectedVariable, tempTerm);
 					counter++;
 					h_dependentPart.addTerm( tempTerm );
 				}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace carl::ran::common {
+
+/**
+ * Sorts a vector of real algebraic numbers and removes duplicates.
+ *
+ * Instead of comparing all pairs (which may refine both operands of every comparison), the numbers are ordered by the lower bounds of their isolating intervals first.
+ * Consecutive numbers whose intervals overlap form a cluster; only clusters with more than one element are sorted with the comparison operators of the numbers.
+ *
+ * @param rans Numbers to sort, sorted and free of duplicates afterwards.
+ * @param bounds Returns the bounds of the isolating interval of a number (or twice its value if it is numeric).
+ */
+template<typename Number, typename RAN, typename Bounds>
+void sort_and_dedup(std::vector<RAN>& rans, Bounds&& bounds) {
+	struct Entry {
+		Number lower;
+		Number upper;
+		bool numeric;
+		std::size_t index;
+	};
+	std::vector<Entry> entries;
+	entries.reserve(rans.size());
+	for (std::size_t i = 0; i < rans.size(); ++i) {
+		auto [lower, upper] = bounds(rans[i]);
+		entries.push_back(Entry{ std::move(lower), std::move(upper), rans[i].is_numeric(), i });
+	}
+	std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+		if (a.lower != b.lower) return a.lower < b.lower;
+		return a.upper < b.upper;
+	});
+
+	std::vector<RAN> result;
+	result.reserve(rans.size());
+	std::vector<RAN> cluster;
+	std::size_t begin = 0;
+	while (begin < entries.size()) {
+		// Isolating intervals are open, hence touching intervals only overlap if both are points.
+		std::size_t end = begin + 1;
+		const Number* upper = &entries[begin].upper;
+		bool upper_closed = entries[begin].numeric;
+		while (end < entries.size()) {
+			const auto& e = entries[end];
+			if (!(e.lower < *upper || (e.lower == *upper && upper_closed && e.numeric))) break;
+			if (*upper < e.upper) {
+				upper = &e.upper;
+				upper_closed = e.numeric;
+			}
+			++end;
+		}
+		if (end == begin + 1) {
+			result.emplace_back(std::move(rans[entries[begin].index]));
+			begin = end;
+			continue;
+		}
+		cluster.clear();
+		for (std::size_t i = begin; i < end; ++i) {
+			cluster.emplace_back(std::move(rans[entries[i].index]));
+		}
+		std::sort(cluster.begin(), cluster.end(), [](const RAN& a, const RAN& b) { return a < b; });
+		auto last = std::unique(cluster.begin(), cluster.end(), [](const RAN& a, const RAN& b) { return a == b; });
+		std::move(cluster.begin(), last, std::back_inserter(result));
+		begin = end;
+	}
+	rans = std::move(result);
+}
+
+}
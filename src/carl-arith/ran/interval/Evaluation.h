@@ -2,6 +2,7 @@
 
 #include <carl-arith/interval/Interval.h>
 #include <carl-arith/poly/umvpoly/functions/IntervalEvaluation.h>
+#include <carl-arith/poly/umvpoly/functions/SignFilter.h>
 #include <carl-arith/interval/evaluate.h>
 #include <carl-arith/constraint/BasicConstraint.h>
 #include <carl-arith/constraint/Simplification.h>
@@ -138,6 +139,70 @@ std::optional<IntRepRealAlgebraicNumber<Number>> evaluate(MultivariatePolynomial
 	}
 }
 
+namespace ran::interval::detail_evaluation {
+
+/**
+ * Decides the constraint p ~ 0, where the value of p is a root of res and contained in interval.
+ *
+ * Let pos_lb be a lower bound on the positive real roots of res and neg_ub an upper bound on the negative real roots.
+ * If the value of p is within (neg_ub,pos_lb), it must be zero.
+ * Hence the interval is refined until it is either positive or negative or contained in (neg_ub,pos_lb).
+ * @param res Polynomial that has the value of p as a root.
+ * @param interval Interval that contains the value of p.
+ * @param relation Relation of the constraint.
+ * @param refine Refines the RANs in p and returns a new interval containing the value of p.
+ */
+template<typename Number, typename Refine>
+boost::tribool evaluate_by_root_bounds(const UnivariatePolynomial<Number>& res, Interval<Number> interval, Relation relation, Refine&& refine) {
+	// compute root bounds
+	auto pos_lb = lagrangePositiveLowerBound(res);
+	CARL_LOG_TRACE("carl.ran.interval", "positive root lower bound: " << pos_lb);
+	if (pos_lb == 0) {
+		// no positive root exists
+		CARL_LOG_DEBUG("carl.ran.interval", "p <= 0");
+		if (relation == Relation::GREATER) {
+			return false;
+		} else if (relation == Relation::LEQ) {
+			return true;
+		}
+	}
+	auto neg_ub = lagrangeNegativeUpperBound(res);
+	CARL_LOG_TRACE("carl.ran.interval", "negative root upper bound: " << neg_ub);
+	if (neg_ub == 0) {
+		// no negative root exists
+		CARL_LOG_DEBUG("carl.ran.interval", "p >= 0");
+		if (relation == Relation::LESS) {
+			return false;
+		} else if (relation == Relation::GEQ) {
+			return true;
+		}
+	}
+
+	if (pos_lb == 0 && neg_ub == 0) {
+		// no positive or negative zero exists
+		CARL_LOG_DEBUG("carl.ran.interval", "p = 0");
+		return carl::evaluate(Sign::ZERO, relation);
+	}
+
+	assert(!carl::is_zero(res));
+
+	// refine the interval until it is either positive or negative or is contained in (neg_ub,pos_lb)
+	CARL_LOG_DEBUG("carl.ran.interval", "Refine until interval is in (" << neg_ub << "," << pos_lb << ") or interval is positive or negative");
+	while (!((neg_ub < interval.lower() || neg_ub == 0) && (interval.upper() < pos_lb || pos_lb == 0))) {
+		interval = refine();
+		auto int_res = carl::evaluate(interval, relation);
+		if (!indeterminate(int_res)) {
+			CARL_LOG_DEBUG("carl.ran.interval", "Got result");
+			return (bool)int_res;
+		}
+	}
+
+	CARL_LOG_DEBUG("carl.ran.interval", "p = 0");
+	return carl::evaluate(Sign::ZERO, relation);
+}
+
+}
+
 template<typename Number>
 boost::tribool evaluate(const BasicConstraint<MultivariatePolynomial<Number>>& c, const Assignment<IntRepRealAlgebraicNumber<Number>>& m, bool refine_model = true, bool use_root_bounds = true) {
 	CARL_LOG_DEBUG("carl.ran.interval", "Evaluating " << c << " on " << m);
@@ -186,6 +251,11 @@ boost::tribool evaluate(const BasicConstraint<MultivariatePolynomial<Number>>& c
 			}
 		}
 
+		if (auto s = carl::filtered_sgn(p, var_to_interval); s) {
+			CARL_LOG_DEBUG("carl.ran.interval", "Result obtained by floating point filter");
+			return evaluate(*s, constr.relation());
+		}
+
 		Interval<Number> interval = carl::evaluate(p, var_to_interval);
 		{
 			CARL_LOG_TRACE("carl.ran.interval", "Interval evaluation of " << p << " under " << var_to_interval << " results in " << interval);
@@ -233,44 +303,7 @@ boost::tribool evaluate(const BasicConstraint<MultivariatePolynomial<Number>>& c
 		CARL_LOG_DEBUG("carl.ran.interval", "p = " << p);
 		CARL_LOG_DEBUG("carl.ran.interval", "-> " << interval);
 
-		// Let pos_lb a lower bound on the positive real roots and neg_ub an upper bound on the negative real roots
-		// Then if the zero of res is in the interval (neg_ub,pos_lb), then it must be zero.
-
-		// compute root bounds
-		auto pos_lb = lagrangePositiveLowerBound(*res);
-		CARL_LOG_TRACE("carl.ran.interval", "positive root lower bound: " << pos_lb);
-		if (pos_lb == 0) {
-			// no positive root exists
-			CARL_LOG_DEBUG("carl.ran.interval", "p <= 0");
-			if (constr.relation() == Relation::GREATER) {
-				return false;
-			} else if (constr.relation() == Relation::LEQ) {
-				return true;
-			}
-		}
-		auto neg_ub = lagrangeNegativeUpperBound(*res);
-		CARL_LOG_TRACE("carl.ran.interval", "negative root upper bound: " << neg_ub);
-		if (neg_ub == 0) {
-			// no negative root exists
-			CARL_LOG_DEBUG("carl.ran.interval", "p >= 0");
-			if (constr.relation() == Relation::LESS) {
-				return false;
-			} else if (constr.relation() == Relation::GEQ) {
-				return true;
-			}
-		}
-
-		if (pos_lb == 0 && neg_ub == 0) {
-			// no positive or negative zero exists
-			CARL_LOG_DEBUG("carl.ran.interval", "p = 0");
-			return evaluate(Sign::ZERO, constr.relation());
-		}
-
-		assert(!carl::is_zero(*res));
-
-		// refine the interval until it is either positive or negative or is contained in (neg_ub,pos_lb)
-		CARL_LOG_DEBUG("carl.ran.interval", "Refine until interval is in (" << neg_ub << "," << pos_lb << ") or interval is positive or negative");
-		while (!((neg_ub < interval.lower() || neg_ub == 0) && (interval.upper() < pos_lb || pos_lb == 0))) {
+		return ran::interval::detail_evaluation::evaluate_by_root_bounds(*res, interval, constr.relation(), [&]() {
 			for (const auto& [var, ran] : m) {
 				if (var_to_interval.find(var) == var_to_interval.end()) continue;
 				ran.refine();
@@ -283,16 +316,8 @@ boost::tribool evaluate(const BasicConstraint<MultivariatePolynomial<Number>>& c
 					var_to_interval[var] = ran.interval();
 				}
 			}
-			interval = carl::evaluate(p, var_to_interval);
-			auto int_res = carl::evaluate(interval, constr.relation());
-			if (!indeterminate(int_res)) {
-				CARL_LOG_DEBUG("carl.ran.interval", "Got result");
-				return (bool)int_res;
-			}
-		}
-
-		CARL_LOG_DEBUG("carl.ran.interval", "p = 0");
-		return evaluate(Sign::ZERO, constr.relation());
+			return carl::evaluate(p, var_to_interval);
+		});
 	}
 }
 
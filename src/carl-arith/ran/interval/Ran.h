@@ -15,6 +15,7 @@
 
 #include "../common/Operations.h"
 #include "../common/NumberOperations.h"
+#include "../common/Sorting.h"
 
 #include <list>
 #include <boost/logic/tribool.hpp>
@@ -71,8 +72,6 @@ private:
 		/// Sign of polynomial at interval.lower()
 		Sign lower_sign;
 
-		content(const Interval<Number>& i)
-			: polynomial(std::nullopt), interval(i), lower_sign(Sign::ZERO) {}
 		content(UnivariatePolynomial<Number>&& p, const Interval<Number>& i)
 			: polynomial(std::move(p)), interval(i), lower_sign(Sign::ZERO) {}
 		content(const UnivariatePolynomial<Number>& p, const Interval<Number>& i)
@@ -84,6 +83,9 @@ private:
 		}
 	};
 
+	/// Value of a rational number, stored inline to avoid the shared content. Empty for irrational numbers.
+	std::optional<Number> m_value;
+	/// Representation of an irrational number, empty for rational numbers.
 	mutable std::shared_ptr<content> m_content;
 
 	static UnivariatePolynomial<Number> replace_variable(const UnivariatePolynomial<Number>& p) {
@@ -91,7 +93,9 @@ private:
 	}
 
 	bool is_consistent() const {
-		if (interval_int().is_point_interval()) {
+		if (!m_content) {
+			return true;
+		} else if (interval_int().is_point_interval()) {
 			return !m_content->polynomial && m_content->lower_sign == Sign::ZERO;
 		} else {
 			if (interval_int().contains(0) || interval_int().contains_integer()) {
@@ -159,41 +163,41 @@ public: // TODO should be private
 
 private:
 	std::optional<Sign> refine_using(const Number& pivot) const {
-		if (interval_int().contains(pivot)) {
-			if (is_numeric()) return Sign::ZERO;
-			else return refine_internal(pivot);
+		if (is_numeric()) {
+			if (value() == pivot) return Sign::ZERO;
+		} else if (interval_int().contains(pivot)) {
+			return refine_internal(pivot);
 		}
 		return std::nullopt;
 	}
 
 	/// Refines until the number is either numeric or the interval does not contain any integer.
 	void refine_to_integrality() const {
-		while (!interval_int().is_point_interval() && interval_int().contains_integer()) {
+		while (!is_numeric() && interval_int().contains_integer()) {
 			refine();
 		}
 	}
 
 public:
 	IntRepRealAlgebraicNumber()
-		: m_content(std::make_shared<content>(Interval<Number>(0))) {}
+		: m_value(0) {}
 
 	IntRepRealAlgebraicNumber(const Number& n)
-		: m_content(std::make_shared<content>(Interval<Number>(n))) {}
+		: m_value(n) {}
 
-	IntRepRealAlgebraicNumber(const UnivariatePolynomial<Number>& p, const Interval<Number>& i)
-		: m_content(std::make_shared<content>(replace_variable(p), i)) {
+	IntRepRealAlgebraicNumber(const UnivariatePolynomial<Number>& p, const Interval<Number>& i) {
 		CARL_LOG_DEBUG("carl.ran.interval", "Creating (" << p << "," << i << ")");
-		assert(!carl::is_zero(polynomial_int()) && polynomial_int().degree() > 0);
-		assert(interval_int().is_open_interval() || interval_int().is_point_interval());
-		// assert(interval_int().is_point_interval() || count_real_roots(sturm_sequence(), interval_int()) == 1);
-		if (interval_int().is_point_interval()) {
-			m_content->simplify_to_point();
-		} else if (polynomial_int().degree() == 1) {
-			Number a = polynomial_int().coefficients()[1];
-			Number b = polynomial_int().coefficients()[0];
-			interval_int() = Interval<Number>(Number(-b / a));
-			m_content->simplify_to_point();
+		assert(!carl::is_zero(p) && p.degree() > 0);
+		assert(i.is_open_interval() || i.is_point_interval());
+		// assert(i.is_point_interval() || count_real_roots(sturm_sequence(), i) == 1);
+		if (i.is_point_interval()) {
+			m_value = i.lower();
+		} else if (p.degree() == 1) {
+			Number a = p.coefficients()[1];
+			Number b = p.coefficients()[0];
+			m_value = Number(-b / a);
 		} else {
+			m_content = std::make_shared<content>(replace_variable(p), i);
 			m_content->lower_sign = carl::sgn(carl::evaluate(polynomial_int(), interval_int().lower()));
 			if (interval_int().contains(0)) refine_using(0);
 			refine_to_integrality();
@@ -212,7 +216,7 @@ public:
 	}
 
 	bool is_numeric() const {
-		return interval_int().is_point_interval();
+		return !m_content || interval_int().is_point_interval();
 	}
 
 	const auto& polynomial() const {
@@ -226,35 +230,46 @@ public:
 
 	const auto& value() const {
 		assert(is_numeric());
-		return interval_int().lower();
+		return m_content ? interval_int().lower() : *m_value;
 	}
 
 	auto& polynomial_int() const {
+		assert(m_content);
 		return *(m_content->polynomial);
 	}
 	auto& interval_int() const {
+		assert(m_content);
 		return m_content->interval;
 	}
+	/// Lower bound of the isolating interval, or the value of a rational number.
+	const Number& lower_int() const {
+		return m_content ? interval_int().lower() : *m_value;
+	}
+	/// Upper bound of the isolating interval, or the value of a rational number.
+	const Number& upper_int() const {
+		return m_content ? interval_int().upper() : *m_value;
+	}
 };
 
 template<typename Number>
 Number branching_point(const IntRepRealAlgebraicNumber<Number>& n) {
+	if (n.is_numeric()) return n.value();
 	return carl::sample(n.interval_int());
 }
 
 template<typename Number>
 Number sample_above(const IntRepRealAlgebraicNumber<Number>& n) {
-	return carl::floor(n.interval_int().upper()) + 1;
+	return carl::floor(n.upper_int()) + 1;
 }
 template<typename Number>
 Number sample_below(const IntRepRealAlgebraicNumber<Number>& n) {
-	return carl::ceil(n.interval_int().lower()) - 1;
+	return carl::ceil(n.lower_int()) - 1;
 }
 template<typename Number>
 Number sample_between(const IntRepRealAlgebraicNumber<Number>& lower, const IntRepRealAlgebraicNumber<Number>& upper) {
-	lower.refine_using(upper.interval_int().lower());
-	upper.refine_using(lower.interval_int().upper());
-	assert(lower.interval_int().upper() <= upper.interval_int().lower());
+	lower.refine_using(upper.lower_int());
+	upper.refine_using(lower.upper_int());
+	assert(lower.upper_int() <= upper.lower_int());
 	if (lower.is_numeric()) {
 		return sample_between(lower.value(), upper);
 	} else if (upper.is_numeric()) {
@@ -266,9 +281,9 @@ Number sample_between(const IntRepRealAlgebraicNumber<Number>& lower, const IntR
 template<typename Number>
 Number sample_between(const IntRepRealAlgebraicNumber<Number>& lower, const Number& upper) {
 	lower.refine_using(upper);
-	assert(lower.interval_int().upper() <= upper);
+	assert(lower.upper_int() <= upper);
 	assert(lower < upper);
-	while (lower.interval_int().upper() == upper)
+	while (lower.upper_int() == upper)
 		lower.refine();
 	if (lower.is_numeric()) {
 		return sample_between(lower.value(), upper);
@@ -279,9 +294,9 @@ Number sample_between(const IntRepRealAlgebraicNumber<Number>& lower, const Numb
 template<typename Number>
 Number sample_between(const Number& lower, const IntRepRealAlgebraicNumber<Number>& upper) {
 	upper.refine_using(lower);
-	assert(lower <= upper.interval_int().lower());
+	assert(lower <= upper.lower_int());
 	assert(lower < upper);
-	while (lower == upper.interval_int().lower())
+	while (lower == upper.lower_int())
 		upper.refine();
 	if (upper.is_numeric()) {
 		return sample_between(lower, upper.value());
@@ -291,47 +306,45 @@ Number sample_between(const Number& lower, const IntRepRealAlgebraicNumber<Numbe
 }
 template<typename Number>
 Number floor(const IntRepRealAlgebraicNumber<Number>& n) {
-	return carl::floor(n.interval_int().lower());
+	return carl::floor(n.lower_int());
 }
 template<typename Number>
 Number ceil(const IntRepRealAlgebraicNumber<Number>& n) {
-	return carl::ceil(n.interval_int().upper());
+	return carl::ceil(n.upper_int());
 }
 
 template<typename Number>
 inline bool is_zero(const IntRepRealAlgebraicNumber<Number>& n) {
-	return carl::is_zero(n.interval_int());
+	return n.is_numeric() && carl::is_zero(n.value());
 }
 
 template<typename Number>
 inline bool is_integer(const IntRepRealAlgebraicNumber<Number>& n) {
-	return n.interval_int().is_point_interval() && carl::is_integer(n.interval_int().lower());
+	return n.is_numeric() && carl::is_integer(n.value());
 }
 
 template<typename Number>
 inline Number integer_below(const IntRepRealAlgebraicNumber<Number>& n) {
-	return carl::floor(n.interval_int().lower());
+	return carl::floor(n.lower_int());
 }
 
 template<typename Number>
 static IntRepRealAlgebraicNumber<Number> abs(const IntRepRealAlgebraicNumber<Number>& n) {
-	assert(!n.interval_int().contains(constant_zero<Number>::get()) || n.interval_int().is_point_interval());
+	if (n.is_numeric()) {
+		return IntRepRealAlgebraicNumber<Number>(carl::abs(n.value()));
+	}
+	assert(!n.interval_int().contains(constant_zero<Number>::get()));
 	if (n.interval_int().is_semi_positive()) {
 		return n;
-	}
-	else {
-		if (n.is_numeric()) {
-			return IntRepRealAlgebraicNumber<Number>(carl::abs(n.value()));
-		} else {
-			return IntRepRealAlgebraicNumber<Number>(n.polynomial_int().negate_variable(), abs(n.interval_int()));
-		}
+	} else {
+		return IntRepRealAlgebraicNumber<Number>(n.polynomial_int().negate_variable(), abs(n.interval_int()));
 	}
 }
 
 template<typename Number>
 std::size_t size(const IntRepRealAlgebraicNumber<Number>& n) {
 	if (n.is_numeric()) {
-		return carl::bitsize(n.interval_int().lower()) + carl::bitsize(n.interval_int().upper());
+		return 2 * carl::bitsize(n.value());
 	} else {
 		return carl::bitsize(n.interval_int().lower()) + carl::bitsize(n.interval_int().upper()) + n.polynomial_int().degree();
 	}
@@ -339,7 +352,7 @@ std::size_t size(const IntRepRealAlgebraicNumber<Number>& n) {
 
 template<typename Number>
 Sign sgn(const IntRepRealAlgebraicNumber<Number>& n) {
-	if (n.interval_int().is_point_interval()) return carl::sgn(n.interval_int().lower());
+	if (n.is_numeric()) return carl::sgn(n.value());
 	assert(!n.interval_int().contains(constant_zero<Number>::get()));
 	if (n.interval_int().is_semi_positive())
 		return Sign::POSITIVE;
@@ -351,6 +364,7 @@ Sign sgn(const IntRepRealAlgebraicNumber<Number>& n) {
 
 template<typename Number>
 Sign sgn(const IntRepRealAlgebraicNumber<Number>& n, const UnivariatePolynomial<Number>& p) {
+	if (n.is_numeric()) return carl::sgn(carl::evaluate(p, n.value()));
 	UnivariatePolynomial<Number> tmp = IntRepRealAlgebraicNumber<Number>::replace_variable(p);
 	if (n.polynomial_int() == tmp) return Sign::ZERO;
 	auto seq = carl::sturm_sequence(n.polynomial_int(), derivative(n.polynomial_int()) * tmp);
@@ -377,6 +391,7 @@ bool contained_in(const IntRepRealAlgebraicNumber<Number>& n, const Interval<Num
 	if (!n.is_numeric() && n.interval_int().contains(i.upper())) {
 		n.refine_internal(i.upper());
 	}
+	if (n.is_numeric()) return i.contains(n.value());
 	return i.contains(n.interval_int());
 }
 
@@ -384,14 +399,18 @@ template<typename Number>
 bool compare(const IntRepRealAlgebraicNumber<Number>& lhs, const IntRepRealAlgebraicNumber<Number>& rhs, const Relation relation) {
 	CARL_LOG_DEBUG("carl.ran.interval", "Compare " << lhs << " " << relation << " " << rhs);
 
-	if (lhs.m_content.get() == rhs.m_content.get()) {
+	if (lhs.m_content && lhs.m_content == rhs.m_content) {
 		CARL_LOG_TRACE("carl.ran.interval", "Contents are equal");
 		return evaluate(Sign::ZERO, relation);
 	}
 
-	if (lhs.interval_int().is_point_interval() && rhs.interval_int().is_point_interval()) {
+	if (lhs.is_numeric() && rhs.is_numeric()) {
 		CARL_LOG_TRACE("carl.ran.interval", "Point interval comparison");
-		return evaluate(lhs.interval_int().lower(), relation, rhs.interval_int().lower());
+		return evaluate(lhs.value(), relation, rhs.value());
+	} else if (lhs.is_numeric()) {
+		return compare(rhs, lhs.value(), turn_around(relation));
+	} else if (rhs.is_numeric()) {
+		return compare(lhs, rhs.value(), relation);
 	}
 
 	if (carl::set_have_intersection(lhs.interval_int(), rhs.interval_int())) {
@@ -461,15 +480,29 @@ bool compare(const IntRepRealAlgebraicNumber<Number>& lhs, const Number& rhs, co
 		else if (relation == Relation::NEQ)
 			return true;
 		else if (relation == Relation::LESS || relation == Relation::LEQ)
-			return lhs.interval_int().upper() <= rhs;
+			return lhs.upper_int() <= rhs;
 		else if (relation == Relation::GREATER || relation == Relation::GEQ)
-			return lhs.interval_int().lower() >= rhs;
+			return lhs.lower_int() >= rhs;
 	}
 	assert(false);
 	return false;
 }
 
 
+/**
+ * Sorts the given numbers and removes duplicates.
+ * Only numbers whose isolating intervals overlap are refined, see ran::common::sort_and_dedup().
+ */
+template<typename Number>
+void sort_and_dedup(std::vector<IntRepRealAlgebraicNumber<Number>>& rans) {
+	ran::common::sort_and_dedup<Number>(rans,
+		[](const IntRepRealAlgebraicNumber<Number>& n) {
+			if (n.is_numeric()) return std::make_pair(n.value(), n.value());
+			return std::make_pair(n.interval().lower(), n.interval().upper());
+		}
+	);
+}
+
 
 template<typename Num>
 std::ostream& operator<<(std::ostream& os, const IntRepRealAlgebraicNumber<Num>& ran) {
@@ -0,0 +1,295 @@
+#pragma once
+
+/**
+ * @file SampleEvaluationContext.h
+ * Evaluation of many polynomials or constraints over the same sample point.
+ *
+ * The free functions carl::evaluate() for IntRepRealAlgebraicNumber prepare the sample for every single call:
+ * they refine the RANs, split the assignment into its rational and irrational part and build the algebraic information (the defining polynomials of the irrational part) for the algebraic substitution.
+ * A SampleEvaluationContext does this once per sample and reuses it for every polynomial evaluated against it.
+ * Refinements of the irrational RANs that are necessary for one polynomial are kept for the following ones.
+ */
+
+#include "Evaluation.h"
+
+#include <carl-common/config.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace carl::ran::interval {
+
+template<typename Number>
+class SampleEvaluationContext {
+public:
+	using Poly = MultivariatePolynomial<Number>;
+	using RAN = IntRepRealAlgebraicNumber<Number>;
+
+private:
+	/// Auxiliary variable for the defining polynomial v - p of the result.
+	Variable m_result_var;
+	/// Rational part of the sample.
+	std::map<Variable, Number> m_rationals;
+	/// Irrational part of the sample. These are private copies that are refined by this context only.
+	Assignment<RAN> m_irrationals;
+	/// Defining polynomials of the irrational part, with the respective variable as main variable.
+	std::map<Variable, UnivariatePolynomial<Poly>> m_algebraic_information;
+
+	SampleEvaluationContext(Variable result_var): m_result_var(result_var) {}
+
+	void add_irrational(Variable var, const RAN& ran) {
+		assert(!ran.is_numeric());
+		m_irrationals.emplace(var, RAN(ran.polynomial(), ran.interval()));
+		m_algebraic_information.emplace(var, replace_main_variable(ran.polynomial(), var).template convert<Poly>());
+	}
+
+	/**
+	 * Substitutes the rational part of the sample and collects the intervals of the irrational part occurring in p.
+	 */
+	Poly prepare(const Poly& poly, std::map<Variable, Interval<Number>>& var_to_interval) const {
+		Poly p = m_rationals.empty() ? poly : carl::substitute(poly, m_rationals);
+		for (const auto& [var, ran] : m_irrationals) {
+			if (!p.has(var)) continue;
+			if (ran.is_numeric()) {
+				// may have become numeric by a refinement in a previous call
+				substitute_inplace(p, var, Poly(ran.value()));
+			} else {
+				var_to_interval.emplace(var, ran.interval());
+			}
+		}
+		return p;
+	}
+
+	/**
+	 * Computes the polynomial whose roots contain the value of p over the irrational part of the sample.
+	 */
+	std::optional<UnivariatePolynomial<Number>> result_polynomial(const Poly& p, const std::map<Variable, Interval<Number>>& var_to_interval) const {
+		std::vector<UnivariatePolynomial<Poly>> algebraic_information;
+		for (const auto& entry : var_to_interval) {
+			algebraic_information.emplace_back(m_algebraic_information.at(entry.first));
+		}
+		// substitute RANs with low degrees first
+		std::sort(algebraic_information.begin(), algebraic_information.end(), [](const auto& a, const auto& b){
+			return a.degree() > b.degree();
+		});
+		return ran::interval::algebraic_substitution(UnivariatePolynomial<Poly>(m_result_var, {Poly(-p), Poly(1)}), algebraic_information);
+	}
+
+	/**
+	 * Refines all RANs occurring in p once and updates p and var_to_interval accordingly.
+	 */
+	void refine(Poly& p, std::map<Variable, Interval<Number>>& var_to_interval) const {
+		for (const auto& [var, ran] : m_irrationals) {
+			if (var_to_interval.find(var) == var_to_interval.end()) continue;
+			ran.refine();
+			if (ran.is_numeric()) {
+				substitute_inplace(p, var, Poly(ran.value()));
+				for (const auto& entry : m_irrationals) {
+					if (!p.has(entry.first)) var_to_interval.erase(entry.first);
+				}
+			} else {
+				var_to_interval[var] = ran.interval();
+			}
+		}
+	}
+
+	/**
+	 * Checks whether the univariate polynomial p vanishes at the single irrational RAN it contains.
+	 */
+	bool vanishes_univariately(const Poly& p, const std::map<Variable, Interval<Number>>& var_to_interval) const {
+		if (var_to_interval.size() != 1) return false;
+		auto poly = carl::to_univariate_polynomial(p);
+		assert(poly.main_var() == var_to_interval.begin()->first);
+		return sgn(m_irrationals.at(var_to_interval.begin()->first), poly) == Sign::ZERO;
+	}
+
+public:
+	/**
+	 * Prepares the given sample for evaluation.
+	 * @param m Variable assignment
+	 * @param refine_model Refine the RANs up to the same precision as carl::evaluate() does.
+	 */
+	explicit SampleEvaluationContext(const Assignment<RAN>& m, bool refine_model = true)
+		: m_result_var(fresh_real_variable())
+	{
+		CARL_LOG_DEBUG("carl.ran.interval", "Preparing evaluation context for " << m);
+		for (const auto& [var, ran] : m) {
+			if (refine_model) {
+				static Number min_width = Number(1) / (Number(1048576)); // 1/2^20, taken from libpoly
+				while (!ran.is_numeric() && ran.interval().diameter() > min_width) {
+					ran.refine();
+				}
+			}
+			if (ran.is_numeric()) {
+				m_rationals.emplace(var, ran.value());
+			} else {
+				add_irrational(var, ran);
+			}
+		}
+	}
+
+	/**
+	 * Creates an independent copy of this context that does not share any RAN with this context.
+	 * Such copies can be used concurrently.
+	 */
+	SampleEvaluationContext clone() const {
+		SampleEvaluationContext res(m_result_var);
+		res.m_rationals = m_rationals;
+		for (const auto& [var, ran] : m_irrationals) {
+			if (ran.is_numeric()) {
+				res.m_rationals.emplace(var, ran.value());
+			} else {
+				res.add_irrational(var, ran);
+			}
+		}
+		return res;
+	}
+
+	const auto& rationals() const {
+		return m_rationals;
+	}
+	const auto& irrationals() const {
+		return m_irrationals;
+	}
+
+	/**
+	 * Evaluate the given polynomial over the sample, see carl::evaluate().
+	 * Returns std::nullopt if the algebraic substitution fails.
+	 */
+	std::optional<RAN> evaluate(const Poly& poly) const {
+		CARL_LOG_DEBUG("carl.ran.interval", "Evaluating " << poly << " in context");
+		std::map<Variable, Interval<Number>> var_to_interval;
+		Poly p = prepare(poly, var_to_interval);
+		if (p.is_number()) {
+			CARL_LOG_DEBUG("carl.ran.interval", "Returning " << p.constant_part());
+			return RAN(p.constant_part());
+		}
+		assert(!var_to_interval.empty());
+		if (vanishes_univariately(p, var_to_interval)) {
+			CARL_LOG_DEBUG("carl.ran.interval", "Returning " << RAN());
+			return RAN();
+		}
+
+		Interval<Number> interval = carl::evaluate(p, var_to_interval);
+		if (interval.is_point_interval()) {
+			CARL_LOG_DEBUG("carl.ran.interval", "Interval is point interval " << interval);
+			return RAN(interval.lower());
+		}
+
+		auto res = result_polynomial(p, var_to_interval);
+		if (!res) {
+			return std::nullopt;
+		}
+		res = carl::squareFreePart(*res);
+		CARL_LOG_TRACE("carl.ran.interval", "res = " << *res);
+
+		auto sturm_seq = sturm_sequence(*res);
+		assert(!carl::is_zero(*res));
+		while (!interval.is_point_interval() && (carl::is_root_of(*res, interval.lower()) || carl::is_root_of(*res, interval.upper()) || count_real_roots(sturm_seq, interval) != 1)) {
+			CARL_LOG_TRACE("carl.ran.interval", "Refinement step");
+			refine(p, var_to_interval);
+			interval = carl::evaluate(p, var_to_interval);
+		}
+		CARL_LOG_DEBUG("carl.ran.interval", "Result is " << *res << " " << interval);
+		if (interval.is_point_interval()) {
+			return RAN(interval.lower());
+		} else {
+			return RAN(*res, interval);
+		}
+	}
+
+	/**
+	 * Evaluate the given constraint over the sample using root bounds, see carl::evaluate().
+	 */
+	boost::tribool evaluate(const BasicConstraint<Poly>& c) const {
+		CARL_LOG_DEBUG("carl.ran.interval", "Evaluating " << c << " in context");
+		std::map<Variable, Interval<Number>> var_to_interval;
+		Poly p = prepare(c.lhs(), var_to_interval);
+		if (p.is_number()) {
+			CARL_LOG_DEBUG("carl.ran.interval", "Left hand side is constant");
+			return carl::evaluate(p.constant_part(), c.relation());
+		}
+		BasicConstraint<Poly> constr = constraint::create_normalized_constraint(p, c.relation());
+		if (constr.is_consistent() != 2) {
+			CARL_LOG_DEBUG("carl.ran.interval", "Constraint already evaluates to value");
+			return constr.is_consistent();
+		}
+		if (constr.lhs() != p) {
+			p = constr.lhs();
+			var_to_interval.clear();
+			for (const auto& [var, ran] : m_irrationals) {
+				if (p.has(var)) var_to_interval.emplace(var, ran.interval());
+			}
+		}
+
+		if (auto s = carl::filtered_sgn(p, var_to_interval); s) {
+			CARL_LOG_DEBUG("carl.ran.interval", "Result obtained by floating point filter");
+			return carl::evaluate(*s, constr.relation());
+		}
+		Interval<Number> interval = carl::evaluate(p, var_to_interval);
+		auto int_res = carl::evaluate(interval, constr.relation());
+		if (!indeterminate(int_res)) {
+			CARL_LOG_DEBUG("carl.ran.interval", "Result obtained by interval evaluation");
+			return (bool)int_res;
+		}
+
+		assert(!var_to_interval.empty());
+		if (vanishes_univariately(p, var_to_interval)) {
+			return carl::evaluate(Sign::ZERO, constr.relation());
+		}
+
+		auto res = result_polynomial(p, var_to_interval);
+		if (!res) {
+			return boost::indeterminate;
+		}
+
+		return detail_evaluation::evaluate_by_root_bounds(*res, interval, constr.relation(), [&]() {
+			refine(p, var_to_interval);
+			return carl::evaluate(p, var_to_interval);
+		});
+	}
+
+	/**
+	 * Evaluates all given polynomials resp. constraints over the sample.
+	 * If num_threads > 1, the inputs are distributed over this many worker threads, each working on its own clone() of this context.
+	 * As the polynomial pools are only synchronized if carl is built with THREAD_SAFE, the evaluation is sequential otherwise.
+	 */
+	template<typename Input>
+	auto evaluate(const std::vector<Input>& inputs, std::size_t num_threads = 1) const {
+		using Result = decltype(evaluate(std::declval<const Input&>()));
+		std::vector<Result> results(inputs.size());
+		#ifndef THREAD_SAFE
+		if (num_threads > 1) {
+			CARL_LOG_WARN("carl.ran.interval", "Parallel evaluation requires THREAD_SAFE, evaluating sequentially.");
+			num_threads = 1;
+		}
+		#endif
+		num_threads = std::min(num_threads, inputs.size());
+		if (num_threads <= 1) {
+			for (std::size_t i = 0; i < inputs.size(); ++i) {
+				results[i] = evaluate(inputs[i]);
+			}
+			return results;
+		}
+		std::atomic<std::size_t> next(0);
+		std::vector<SampleEvaluationContext> contexts;
+		for (std::size_t t = 0; t < num_threads; ++t) {
+			contexts.emplace_back(clone());
+		}
+		std::vector<std::thread> workers;
+		for (std::size_t t = 0; t < num_threads; ++t) {
+			workers.emplace_back([&inputs, &results, &next, &context = contexts[t]]() {
+				for (std::size_t i = next++; i < inputs.size(); i = next++) {
+					results[i] = context.evaluate(inputs[i]);
+				}
+			});
+		}
+		for (auto& w: workers) {
+			w.join();
+		}
+		return results;
+	}
+};
+
+}
@@ -482,6 +482,19 @@ bool compare(const LPRealAlgebraicNumber& lhs, const NumberType& rhs, const Rela
 }
 
 
+void sort_and_dedup(std::vector<LPRealAlgebraicNumber>& rans) {
+	ran::common::sort_and_dedup<NumberType>(rans,
+		[](const LPRealAlgebraicNumber& n) {
+			if (n.is_numeric()) {
+				NumberType value = n.value();
+				return std::make_pair(value, value);
+			}
+			return std::make_pair(n.get_lower_bound(), n.get_upper_bound());
+		}
+	);
+}
+
+
 std::ostream& operator<<(std::ostream& os, const LPRealAlgebraicNumber& ran) {
 	char* str = lp_algebraic_number_to_string(ran.get_internal());
 	os << str;
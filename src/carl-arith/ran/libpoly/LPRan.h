@@ -15,6 +15,7 @@
 
 #include "../common/Operations.h"
 #include "../common/NumberOperations.h"
+#include "../common/Sorting.h"
 
 
 namespace carl {
@@ -176,6 +177,12 @@ Sign sgn(const LPRealAlgebraicNumber& n);
 Sign sgn(const LPRealAlgebraicNumber& n, const UnivariatePolynomial<LPRealAlgebraicNumber::NumberType>& p);
 bool contained_in(const LPRealAlgebraicNumber& n, const Interval<LPRealAlgebraicNumber::NumberType>& i);
 
+/**
+ * Sorts the given numbers and removes duplicates.
+ * Only numbers whose isolating intervals overlap are refined, see ran::common::sort_and_dedup().
+ */
+void sort_and_dedup(std::vector<LPRealAlgebraicNumber>& rans);
+
 std::ostream& operator<<(std::ostream& os, const LPRealAlgebraicNumber& ran);
 
 template<>
@@ -16,6 +16,7 @@
 #include <cmath>
 #include <iterator>
 #include <list>
+#include <map>
 #include <queue>
 
 
@@ -40,6 +41,8 @@ private:
 	std::list<uint> mAdaHelper;
 	Eigen::MatrixXf mMatrix;
 	bool mNeedsUpdate = false;
+	// results of getSigns() for the currently processed polynomials
+	std::map<Polynomial, std::list<SignCondition>> mSignsCache;
 	
 	
 	
@@ -61,7 +64,8 @@ public:
 		mAda(other.mAda),
 		mAdaHelper(other.mAdaHelper),
 		mMatrix(other.mMatrix),
-		mNeedsUpdate(other.mNeedsUpdate)
+		mNeedsUpdate(other.mNeedsUpdate),
+		mSignsCache(other.mSignsCache)
 	{}
 	
 	uint sizeOfZeroSet() const {
@@ -70,6 +74,7 @@ public:
 		return uint(res);
 	}
 	
+	const auto& taqManager() const { return mTaQ; }
 	const auto& processedPolynomials() const { return mP; }
 	const auto& signs() const { return mSigns; }
 	const auto& products() const { return mProducts; }
@@ -373,11 +378,17 @@ public:
 	 * MAIN INTERFACES
 	 */
 	std::list<SignCondition> getSigns(const Polynomial& p) {
+		auto it = mSignsCache.find(p);
+		if (it != mSignsCache.end()) {
+			CARL_LOG_TRACE("carl.thom.sign", "found signs of " << p << " in cache");
+			return it->second;
+		}
 		std::list<Polynomial> dummyProducts;
 		std::list<Alpha> dummyAda;
 		std::list<uint> dummyHelper;
 		Eigen::MatrixXf dummyMatrix;
 		std::list<SignCondition> newSigns = getSigns(p, dummyProducts, dummyAda, dummyHelper, dummyMatrix);
+		mSignsCache.emplace(p, newSigns);
 		return newSigns;
 	}
 	
@@ -387,6 +398,7 @@ public:
 		std::list<uint> newHelper;
 		Eigen::MatrixXf newMatrix;
 		std::list<SignCondition> newSigns = getSigns(p, newProducts, newAda, newHelper, newMatrix);
+		mSignsCache.clear();
 		mNeedsUpdate = true;
 		if(mP.empty()) {
 			mAda = newAda;
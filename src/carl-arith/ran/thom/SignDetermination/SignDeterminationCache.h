@@ -0,0 +1,100 @@
+/*
+ * File:   SignDeterminationCache.h
+ *
+ * Sign determination objects for univariate polynomials, shared by all Thom
+ * encodings of the same polynomial.
+ */
+
+#pragma once
+
+#include "SignDetermination.h"
+#include "../ThomUtil.h"
+
+#include <list>
+#include <map>
+#include <memory>
+
+namespace carl {
+
+/*
+ * The sign determination object of the real roots of a univariate polynomial
+ * only depends on the polynomial. Sharing it between all Thom encodings of this
+ * polynomial (even if they stem from different calls to the root finder) lets
+ * comparisons reuse the memoized Tarski queries and sign conditions instead of
+ * recomputing them for every new pair of encodings.
+ *
+ * Entries are only kept as long as some Thom encoding refers to them.
+ *
+ * Sign determination objects are modified by every query and the memoized
+ * Tarski queries are not synchronized. Hence every thread has its own cache,
+ * and Thom encodings must not be shared between threads.
+ */
+template<typename Number>
+class SignDeterminationCache {
+
+	using Polynomial = MultivariatePolynomial<Number>;
+
+	struct Entry {
+		std::weak_ptr<SignDetermination<Number>> sd;
+		std::list<SignCondition> signs;
+	};
+
+	std::map<std::pair<Polynomial, Variable>, Entry> mEntries;
+
+	SignDeterminationCache() = default;
+
+	/*
+	 * Sets up the sign determination on the roots of p and adds derivatives
+	 * of p until all roots are distinguished.
+	 */
+	static std::pair<std::shared_ptr<SignDetermination<Number>>, std::list<SignCondition>> compute(const Polynomial& p, Variable::Arg mainVar) {
+		std::list<Polynomial> derivatives = der(p, mainVar, 1, p.degree(mainVar));
+		std::vector<Polynomial> zeroSet = {p};
+		auto sd = std::make_shared<SignDetermination<Number>>(zeroSet.begin(), zeroSet.end());
+
+		uint numOfRoots = sd->sizeOfZeroSet();
+		std::list<SignCondition> signs = {};
+		auto it = derivatives.rbegin();
+		while(signs.size() < numOfRoots) {
+			signs = sd->getSignsAndAdd(*it);
+			it++;
+		}
+		return std::make_pair(sd, signs);
+	}
+
+public:
+	SignDeterminationCache(const SignDeterminationCache&) = delete;
+	SignDeterminationCache& operator=(const SignDeterminationCache&) = delete;
+
+	/*
+	 * Returns the cache of the calling thread.
+	 */
+	static SignDeterminationCache& getInstance() {
+		static thread_local SignDeterminationCache cache;
+		return cache;
+	}
+
+	/*
+	 * Returns the sign determination object for the roots of p together with
+	 * the sign conditions of the roots.
+	 */
+	std::pair<std::shared_ptr<SignDetermination<Number>>, std::list<SignCondition>> get(const Polynomial& p, Variable::Arg mainVar) {
+		auto key = std::make_pair(p, mainVar);
+		auto it = mEntries.find(key);
+		if(it != mEntries.end()) {
+			if(auto sd = it->second.sd.lock()) {
+				CARL_LOG_TRACE("carl.thom.sign", "reusing sign determination of " << p);
+				return std::make_pair(sd, it->second.signs);
+			}
+		}
+		auto res = compute(p, mainVar);
+		for(auto entry = mEntries.begin(); entry != mEntries.end(); ) {
+			if(entry->second.sd.expired()) entry = mEntries.erase(entry);
+			else entry++;
+		}
+		mEntries[key] = Entry{ res.first, res.second };
+		return res;
+	}
+}; // class SignDeterminationCache
+
+} // namespace carl
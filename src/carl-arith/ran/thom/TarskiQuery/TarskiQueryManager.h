@@ -8,6 +8,8 @@
 #pragma once
 
 #include <iterator>
+#include <map>
+#include <memory>
 
 #include "MultiplicationTable.h"
 #include "MultivariateTarskiQuery.h"
@@ -19,7 +21,8 @@ namespace carl {
         
 /*
  * The Tarski query manager is a class designed to manage the computation of Tarski queries.
- * 
+ * Query results are memoized; copies of a manager share the same cache, as they
+ * refer to the same zero set.
  */ 
 template<typename Number>
 class TarskiQueryManager {
@@ -38,7 +41,8 @@ private:
         MultiplicationTable<Number> mTab;
         bool mTrivialGb = false;
         
-        mutable std::map<Polynomial, QueryResultType> mCache;
+        // query results, shared by all copies of this manager
+        std::shared_ptr<std::map<Polynomial, QueryResultType>> mCache = std::make_shared<std::map<Polynomial, QueryResultType>>();
         
 public:
         TarskiQueryManager() = default;
@@ -112,6 +116,13 @@ public:
                 return (*this)(Polynomial(c));
         }
         
+        /*
+         * number of memoized query results, shared by all copies of this manager
+         */
+        std::size_t cacheSize() const {
+                return mCache->size();
+        }
+        
         Polynomial reduceProduct(const Polynomial& a, const Polynomial& b) const {
                 if(this->isUnivariateManager()) {
                         // todo: implement
@@ -135,8 +146,8 @@ private:
          * looks for the normalization of p in the cache
          */
         bool getCached(const Polynomial& p, QueryResultType& res) const {
-                auto it = mCache.find(p.normalize());
-                if(it != mCache.end()) {
+                auto it = mCache->find(p.normalize());
+                if(it != mCache->end()) {
 						res = int(sgn(p.lcoeff())) * (it->second);
                         return true;
                 }
@@ -147,7 +158,7 @@ private:
          * writes normalized p with correspoding result in cache
          */
         void cache(const Polynomial& p, const QueryResultType res) const {
-                mCache.insert(std::make_pair(p.normalize(), int(sgn(p.lcoeff())) * res));
+                mCache->insert(std::make_pair(p.normalize(), int(sgn(p.lcoeff())) * res));
         }
         
 }; // class TarskiQueryManager
@@ -9,6 +9,7 @@
 
 #include <carl-arith/core/Sign.h>
 #include <carl-arith/poly/umvpoly/UnivariatePolynomial.h>
+#include <carl-arith/poly/umvpoly/functions/SturmSequence.h>
 
 namespace carl {
 
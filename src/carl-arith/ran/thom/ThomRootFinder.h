@@ -9,8 +9,9 @@
 
 #include <carl-arith/interval/Interval.h>
 #include "ThomEncoding.h"
+#include "SignDetermination/SignDeterminationCache.h"
 #include "ThomUtil.h"
-#include "ran_thom.h"
+
 
 namespace carl {
         
@@ -126,21 +127,10 @@ std::list<ThomEncoding<Number>> realRootsThom(
         
         
         if(point_ptr == nullptr) {
-                std::list<Polynomial> derivatives = der(p, mainVar, 1, p.degree(mainVar));
-                
-                std::vector<Polynomial> zeroSet = {p};
-                SignDetermination<Number> sd(zeroSet.begin(), zeroSet.end());
-                
-                uint numOfRoots = sd.sizeOfZeroSet();
-                if(numOfRoots == 0) return {};
+                // shared with all other encodings of roots of p
+                auto [sd_ptr, signs] = SignDeterminationCache<Number>::getInstance().get(p, mainVar);
+                if(signs.empty()) return {};
                 
-                std::list<SignCondition> signs = {};
-                auto it = derivatives.rbegin();
-                while(signs.size() < numOfRoots) {
-                        signs = sd.getSignsAndAdd(*it);
-                        it++;
-                }
-                std::shared_ptr<SignDetermination<Number>> sd_ptr = std::make_shared<SignDetermination<Number>>(sd);
                 for(const auto& sigma : signs) {
                         ThomEncoding<Number> newEncoding(
                                 sigma,
@@ -1,7 +1,7 @@
 #pragma once
 
 #include "ThomEncoding.h"
-#include "../common/Operations.h""
+#include "../common/Operations.h"
 
 
 #include <memory>
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "../config.h"
+
+#include <atomic>
+#include <utility>
+
+namespace carl {
+
+/**
+ * Lazily computed value that never changes once it has been computed.
+ *
+ * The value is computed on first access and published by a single atomic pointer.
+ * Later accesses only perform an acquire load, in contrast to locking a mutex on every access.
+ * If carl is built with THREAD_SAFE and multiple threads access the value concurrently before it is published,
+ * each of them may compute it, but only the first result is published and all threads return the same object.
+ * Hence the computation must be free of side effects.
+ */
+template<typename T>
+class PublishOnce {
+#ifdef THREAD_SAFE
+	mutable std::atomic<T*> mValue{nullptr};
+#else
+	mutable T* mValue = nullptr;
+#endif
+public:
+	PublishOnce() = default;
+	PublishOnce(const PublishOnce&) = delete;
+	PublishOnce& operator=(const PublishOnce&) = delete;
+	~PublishOnce() {
+		delete get_if();
+	}
+
+	/// Returns the value if it has already been published, nullptr otherwise.
+	const T* get_if() const {
+#ifdef THREAD_SAFE
+		return mValue.load(std::memory_order_acquire);
+#else
+		return mValue;
+#endif
+	}
+
+	/**
+	 * Returns the value, computing it with compute() if it has not yet been published.
+	 * @param compute Callable returning a T.
+	 */
+	template<typename F>
+	const T& get(F&& compute) const {
+		if (const T* value = get_if()) return *value;
+		T* fresh = new T(std::forward<F>(compute)());
+#ifdef THREAD_SAFE
+		T* expected = nullptr;
+		if (!mValue.compare_exchange_strong(expected, fresh, std::memory_order_acq_rel, std::memory_order_acquire)) {
+			delete fresh;
+			return *expected;
+		}
+#else
+		mValue = fresh;
+#endif
+		return *fresh;
+	}
+};
+
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace carl {
+
+/**
+ * Hands out uninitialized storage of a fixed size and alignment, carved from large slabs.
+ *
+ * Compared to allocating every object with new, this avoids the per-allocation overhead of the general purpose allocator
+ * and keeps objects that are allocated together close in memory.
+ * Released storage is put into a free list and reused by later allocations; the slabs themselves are only returned when the allocator is destroyed.
+ * The allocator is not synchronized, the owner has to lock if necessary.
+ * @tparam Size Size of a single allocation in bytes.
+ * @tparam Align Alignment of a single allocation.
+ * @tparam SlabObjects Number of allocations per slab.
+ */
+template<std::size_t Size, std::size_t Align, std::size_t SlabObjects = 1024>
+class SlabAllocator {
+	union Node {
+		Node* next;
+		alignas(Align) unsigned char storage[Size];
+	};
+	static_assert(SlabObjects > 0, "Slabs must hold at least one object.");
+
+	std::vector<std::unique_ptr<Node[]>> mSlabs;
+	/// Head of the list of released nodes.
+	Node* mFree = nullptr;
+	/// Number of nodes of the last slab that were never handed out.
+	std::size_t mRemaining = 0;
+	/// Number of allocations that have not been released.
+	std::size_t mLive = 0;
+public:
+	SlabAllocator() = default;
+	SlabAllocator(const SlabAllocator&) = delete;
+	SlabAllocator& operator=(const SlabAllocator&) = delete;
+
+	void* allocate() {
+		++mLive;
+		if (mFree != nullptr) {
+			Node* res = mFree;
+			mFree = res->next;
+			return res->storage;
+		}
+		if (mRemaining == 0) {
+			mSlabs.emplace_back(new Node[SlabObjects]);
+			mRemaining = SlabObjects;
+		}
+		--mRemaining;
+		return mSlabs.back()[SlabObjects - mRemaining - 1].storage;
+	}
+
+	void deallocate(void* p) {
+		assert(p != nullptr);
+		assert(mLive > 0);
+		--mLive;
+		Node* n = reinterpret_cast<Node*>(p);
+		n->next = mFree;
+		mFree = n;
+	}
+
+	/// Number of allocations that have not been released.
+	std::size_t size() const {
+		return mLive;
+	}
+	/// Number of allocations that fit into the current slabs.
+	std::size_t capacity() const {
+		return mSlabs.size() * SlabObjects;
+	}
+};
+
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <carl-common/memory/Pool.h>
+#include <carl-common/memory/PublishOnce.h>
 #include <carl-common/config.h>
 #include <carl-arith/core/Variables.h>
 #include <carl-arith/poly/umvpoly/functions/VarInfo.h>
@@ -27,24 +28,38 @@ class Constraint;
 template<typename Poly>
 using Constraints = std::set<Constraint<Poly>, carl::less<Constraint<Poly>, false>>;
 
+/**
+ * A constraint p ~ 0 in the form q ~' b, where q has no constant part, a positive leading coefficient and coprime integral coefficients.
+ * Constraints that only differ in b and ~' bound the same polynomial q, which is used to combine bounds in conjunctions and disjunctions.
+ */
+template<typename Pol>
+struct NormalizedBound {
+	/// The polynomial q.
+	Pol poly;
+	/// The bound b.
+	typename Pol::NumberType bound;
+	/// The relation ~'.
+	Relation relation;
+	/// Whether p was multiplied by a negative factor, i.e. whether ~' is ~ turned around.
+	bool turned;
+	/// The hash of q, such that bounds can be grouped by q without hashing it again.
+	std::size_t hash;
+};
+
 template<typename Pol>
 struct CachedConstraintContent {
 	/// Basic constraint.
 	BasicConstraint<Pol> m_constraint;
 	/// Cache for the factorization.
-	mutable Factors<Pol> m_lhs_factorization;
+	PublishOnce<Factors<Pol>> m_lhs_factorization;
 	/// A container which includes all variables occurring in the polynomial considered by this constraint.
-	mutable carlVariables m_variables;
+	PublishOnce<carlVariables> m_variables;
 	/// A map which stores information about properties of the variables in this constraint.
-	mutable VarsInfo<Pol> m_var_info_map;
-	#ifdef THREAD_SAFE
-	/// Mutex for access to variable information map.
-	std::mutex m_var_info_map_mutex;
-	/// Mutex for access to the factorization.
-	std::mutex m_lhs_factorization_mutex;
-	/// Mutex for access to the variables.
-	std::mutex m_variables_mutex;
-	#endif
+	PublishOnce<VarsInfo<Pol>> m_var_info_map;
+	/// Like m_var_info_map, but including the coefficients.
+	PublishOnce<VarsInfo<Pol>> m_var_info_map_coeffs;
+	/// Cache for the normalized bound.
+	PublishOnce<NormalizedBound<Pol>> m_normalized_bound;
 
 	CachedConstraintContent(BasicConstraint<Pol>&& c) : m_constraint(std::move(c)) {}
 	const auto& key() const { return m_constraint; }
@@ -128,60 +143,65 @@ public:
      * @return A container containing all variables occurring in the polynomial of this constraint.
      */
 	const auto& variables() const {
-		#ifdef THREAD_SAFE
-		m_element->m_variables_mutex.lock();
-		#endif
-		if (m_element->m_variables.empty()) {
-			m_element->m_variables = carl::variables(lhs());
-		}
-		#ifdef THREAD_SAFE
-		m_element->m_variables_mutex.unlock();
-		#endif
-		return m_element->m_variables;
+		return m_element->m_variables.get([this]() {
+			auto vars = carl::variables(lhs());
+			// Compact the container now, such that reading the shared container does not modify it.
+			vars.compact(true);
+			return vars;
+		});
 	}
 
 	const Factors<Pol>& lhs_factorization() const {
-		#ifdef THREAD_SAFE
-		m_element->m_lhs_factorization_mutex.lock();
-		#endif
-		if (m_element->m_lhs_factorization.empty()) {
-			m_element->m_lhs_factorization = carl::factorization(lhs());
-		}
-		#ifdef THREAD_SAFE
-		m_element->m_lhs_factorization_mutex.unlock();
-		#endif
-		return m_element->m_lhs_factorization;
+		return m_element->m_lhs_factorization.get([this]() { return carl::factorization(lhs()); });
 	}
 
 	/**
      * @param variable The variable to find variable information for.
      * @tparam gatherCoeff
      * @return The whole variable information object.
-     * Note, that if the given variable is not in this constraints, this method fails.
+     * If the given variable does not occur in this constraint, the returned information is empty.
      * Furthermore, the variable information returned do provide coefficients only, if
      * the given flag gatherCoeff is set to true.
      */
 	template<bool gatherCoeff = false>
 	const VarInfo<Pol>& var_info(const Variable variable) const {
-		#ifdef THREAD_SAFE
-		m_element->m_var_info_map_mutex.lock();
-		#endif
-		if (!m_element->m_var_info_map.occurs(variable) || (gatherCoeff && !m_element->m_var_info_map.var(variable).has_coeff())) {
-			m_element->m_var_info_map.data()[variable] = carl::var_info(lhs(),variable,gatherCoeff);
-			assert(m_element->m_var_info_map.occurs(variable));
-		}
-		#ifdef THREAD_SAFE
-		m_element->m_var_info_map_mutex.unlock();
-		#endif
-		return m_element->m_var_info_map.var(variable);
+		static const VarInfo<Pol> none;
+		const auto& infos = var_info<gatherCoeff>();
+		return infos.occurs(variable) ? infos.var(variable) : none;
 	}
 
+	/**
+	 * @return The variable information for all variables of this constraint. Once the information with coefficients
+	 * has been computed, it is also returned if no coefficients are requested.
+	 */
 	template<bool gatherCoeff = false>
 	const VarsInfo<Pol>& var_info() const {
-		for (const auto& var : variables()) {
-			var_info<gatherCoeff>(var);
+		if constexpr (!gatherCoeff) {
+			if (const auto* infos = m_element->m_var_info_map_coeffs.get_if()) return *infos;
+			return m_element->m_var_info_map.get([this]() { return carl::vars_info(lhs(), false); });
+		} else {
+			return m_element->m_var_info_map_coeffs.get([this]() { return carl::vars_info(lhs(), true); });
 		}
-		return m_element->m_var_info_map;
+	}
+
+	/**
+	 * @return This constraint as a bound on a normalized polynomial, see NormalizedBound.
+	 * Must only be called if the constraint is not trivially consistent or inconsistent.
+	 */
+	const NormalizedBound<Pol>& normalized_bound() const {
+		return m_element->m_normalized_bound.get([this]() {
+			assert(is_consistent() == 2);
+			using Number = typename Pol::NumberType;
+			bool turned = lhs().lterm().coeff() < Number(0);
+			Number bound = turned ? lhs().constant_part() : Number(-lhs().constant_part());
+			Pol poly = turned ? Pol(-lhs() + bound) : Pol(lhs() + bound);
+			Number cf(poly.coprime_factor());
+			assert(cf > 0);
+			bound *= cf;
+			poly *= cf;
+			std::size_t hash = std::hash<Pol>()(poly);
+			return NormalizedBound<Pol>{ std::move(poly), std::move(bound), turned ? carl::turn_around(relation()) : relation(), turned, hash };
+		});
 	}
 
 	/**
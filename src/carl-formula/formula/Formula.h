@@ -79,13 +79,47 @@ namespace carl
                     FormulaPool<Pol>::getInstance().reg( _content );
             }
 
-            #ifdef THREAD_SAFE
-            #define ACTIVITY_LOCK_GUARD std::lock_guard<std::mutex> lock1( mpContent->mActivityMutex );
-            #define VARIABLES_LOCK_GUARD std::lock_guard<std::mutex> lock3( mpContent->mVariablesMutex );
-            #else
-            #define ACTIVITY_LOCK_GUARD
-            #define VARIABLES_LOCK_GUARD
-            #endif
+            /// Tag for taking over a usage that has already been registered, see FormulaPool::acquire().
+            struct Registered {};
+
+            Formula( const FormulaContent<Pol>* _content, Registered ):
+                mpContent( _content )
+            {}
+
+            /**
+             * Collects the variables of this formula, assuming that the variables of all direct subformulas are already cached.
+             */
+            Variables collect_variables() const
+            {
+                auto merge = []( Variables& vars, const Formula& sub ) {
+                    assert( sub.mpContent->mVariables.get_if() != nullptr );
+                    const Variables& subVars = *sub.mpContent->mVariables.get_if();
+                    vars.insert( subVars.begin(), subVars.end() );
+                };
+                Variables vars;
+                switch( mpContent->mType )
+                {
+                    case FormulaType::AND:
+                    case FormulaType::OR:
+                    case FormulaType::IFF:
+                    case FormulaType::XOR:
+                    case FormulaType::IMPLIES:
+                    case FormulaType::ITE:
+                        for( const auto& sub: subformulas() )
+                            merge( vars, sub );
+                        return vars;
+                    case FormulaType::NOT:
+                        merge( vars, subformula() );
+                        return vars;
+                    case FormulaType::EXISTS:
+                    case FormulaType::FORALL:
+                        vars.insert( quantified_variables().begin(), quantified_variables().end() );
+                        merge( vars, quantified_formula() );
+                        return vars;
+                    default:
+                        return carl::variables( *this ).as_set();
+                }
+            }
 
         public:
 
@@ -96,79 +130,79 @@ namespace carl
             static void init( FormulaContent<Pol>& _content );
 
             explicit Formula( FormulaType _type = FALSE ):
-                Formula( FormulaPool<Pol>::getInstance().create( _type ) )
+                Formula( FormulaPool<Pol>::getInstance().acquire( _type ), Registered() )
             {}
 
             explicit Formula( Variable::Arg _booleanVar ):
-                Formula( FormulaPool<Pol>::getInstance().create( _booleanVar ) )
+                Formula( FormulaPool<Pol>::getInstance().acquire( _booleanVar ), Registered() )
             {}
 
             explicit Formula( const Pol& _pol, Relation _rel ):
-                Formula( FormulaPool<Pol>::getInstance().create( Constraint<Pol>( _pol, _rel ) ) )
+                Formula( FormulaPool<Pol>::getInstance().acquire( Constraint<Pol>( _pol, _rel ) ), Registered() )
             {}
 
             explicit Formula( const Constraint<Pol>& _constraint ):
-                Formula( FormulaPool<Pol>::getInstance().create( _constraint ) )
+                Formula( FormulaPool<Pol>::getInstance().acquire( _constraint ), Registered() )
             {}
 
 			explicit Formula( const VariableComparison<Pol>& _variableComparison ):
-				Formula( FormulaPool<Pol>::getInstance().create( _variableComparison ) )
+				Formula( FormulaPool<Pol>::getInstance().acquire( _variableComparison ), Registered() )
 			{}
 
 			explicit Formula( const VariableAssignment<Pol>& _variableAssignment ):
-				Formula( FormulaPool<Pol>::getInstance().create( _variableAssignment ) )
+				Formula( FormulaPool<Pol>::getInstance().acquire( _variableAssignment ), Registered() )
 			{}
 
             explicit Formula( const BVConstraint& _constraint ):
-                Formula( FormulaPool<Pol>::getInstance().create( _constraint ) )
+                Formula( FormulaPool<Pol>::getInstance().acquire( _constraint ), Registered() )
             {}
 
             explicit Formula( FormulaType _type, Formula&& _subformula ):
-                Formula(FormulaPool<Pol>::getInstance().create(_type, std::move(_subformula)))
+                Formula( FormulaPool<Pol>::getInstance().acquire( _type, std::move(_subformula) ), Registered() )
             {}
 
             explicit Formula( FormulaType _type, const Formula& _subformula ):
-                Formula(FormulaPool<Pol>::getInstance().create(_type, std::move(Formula(_subformula))))
+                Formula( FormulaPool<Pol>::getInstance().acquire( _type, std::move(Formula(_subformula)) ), Registered() )
             {}
 
             explicit Formula( FormulaType _type, const Formula& _subformulaA, const Formula& _subformulaB ):
-                Formula( FormulaPool<Pol>::getInstance().create( _type, {_subformulaA, _subformulaB} ))
+                Formula( FormulaPool<Pol>::getInstance().acquire( _type, Formulas<Pol>({_subformulaA, _subformulaB}) ), Registered() )
             {
                 assert( _type == FormulaType::AND || _type == FormulaType::IFF || _type == FormulaType::IMPLIES || _type == FormulaType::OR || _type == FormulaType::XOR );
             }
 
             explicit Formula( FormulaType _type, const Formula& _subformulaA, const Formula& _subformulaB, const Formula& _subformulaC):
-                Formula( FormulaPool<Pol>::getInstance().create(_type, {_subformulaA, _subformulaB, _subformulaC}))
+                Formula( FormulaPool<Pol>::getInstance().acquire( _type, Formulas<Pol>({_subformulaA, _subformulaB, _subformulaC}) ), Registered() )
             {}
 
             explicit Formula( FormulaType _type, const FormulasMulti<Pol>& _subformulas ):
-                Formula( FormulaPool<Pol>::getInstance().create( _subformulas ) )
+                Formula( FormulaPool<Pol>::getInstance().acquire( _subformulas ), Registered() )
             {
                 assert( _type == FormulaType::XOR );
             }
 
             explicit Formula( FormulaType _type, const Formulas<Pol>& _subasts ):
-                Formula( FormulaPool<Pol>::getInstance().create( _type, _subasts ) )
+                Formula( FormulaPool<Pol>::getInstance().acquire( _type, _subasts ), Registered() )
             {}
 
             explicit Formula( FormulaType _type, Formulas<Pol>&& _subasts ):
-                Formula( FormulaPool<Pol>::getInstance().create( _type, std::move(_subasts) ) )
+                Formula( FormulaPool<Pol>::getInstance().acquire( _type, std::move(_subasts) ), Registered() )
             {}
 
             explicit Formula( FormulaType _type, const std::initializer_list<Formula<Pol>>& _subasts ):
-                Formula( FormulaPool<Pol>::getInstance().create( _type, std::move(Formulas<Pol>(_subasts.begin(), _subasts.end()) ) ))
+                Formula( FormulaPool<Pol>::getInstance().acquire( _type, std::move(Formulas<Pol>(_subasts.begin(), _subasts.end()) ) ), Registered() )
             {}
 
             explicit Formula( FormulaType _type, const FormulaSet<Pol>& _subasts ):
-                Formula( FormulaPool<Pol>::getInstance().create( _type, std::move(Formulas<Pol>(_subasts.begin(), _subasts.end()) ) ))
+                Formula( FormulaPool<Pol>::getInstance().acquire( _type, std::move(Formulas<Pol>(_subasts.begin(), _subasts.end()) ) ), Registered() )
             {}
 
             explicit Formula( FormulaType _type, FormulaSet<Pol>&& _subasts ):
-                Formula( FormulaPool<Pol>::getInstance().create( _type, std::move(Formulas<Pol>(_subasts.begin(), _subasts.end()) ) ))
+                Formula( FormulaPool<Pol>::getInstance().acquire( _type, std::move(Formulas<Pol>(_subasts.begin(), _subasts.end()) ) ), Registered() )
             {}
 
             explicit Formula( FormulaType _type, std::vector<Variable>&& _vars, const Formula& _term ):
-                Formula( FormulaPool<Pol>::getInstance().create( _type, std::move( _vars ), _term ) )
+                Formula( FormulaPool<Pol>::getInstance().acquire( _type, std::move( _vars ), _term ), Registered() )
             {}
 
             explicit Formula( FormulaType _type, const std::vector<Variable>& _vars, const Formula& _term ):
@@ -176,15 +210,15 @@ namespace carl
             {}
 
             explicit Formula( const UTerm& _lhs, const UTerm& _rhs, bool _negated ):
-                Formula( FormulaPool<Pol>::getInstance().create( _lhs, _rhs, _negated ) )
+                Formula( FormulaPool<Pol>::getInstance().acquire( _lhs, _rhs, _negated ), Registered() )
             {}
 
             explicit Formula( UEquality&& _eq ):
-                Formula( FormulaPool<Pol>::getInstance().create( std::move( _eq ) ) )
+                Formula( FormulaPool<Pol>::getInstance().acquire( std::move( _eq ) ), Registered() )
             {}
 
             explicit Formula( const UEquality& _eq ):
-                Formula( FormulaPool<Pol>::getInstance().create( std::move( UEquality( _eq ) ) ) )
+                Formula( FormulaPool<Pol>::getInstance().acquire( std::move( UEquality( _eq ) ) ), Registered() )
             {}
 
             Formula( const Formula& _formula ):
@@ -234,7 +268,6 @@ namespace carl
              */
             double activity() const
             {
-                ACTIVITY_LOCK_GUARD
                 return mpContent->mActivity;
             }
 
@@ -244,7 +277,6 @@ namespace carl
              */
             void set_activity( double _activity ) const
             {
-                ACTIVITY_LOCK_GUARD
                 mpContent->mActivity = _activity;
             }
 
@@ -296,13 +328,22 @@ namespace carl
                 return mpContent->mProperties;
             }
 
+            /**
+             * @return The variables occurring in this formula.
+             * The variables are collected bottom-up and cached for every subformula: the variables of a formula are merged
+             * from the cached variables of its direct subformulas, and subformulas whose variables are already cached are not traversed again.
+             */
             const Variables& variables() const
             {
-                VARIABLES_LOCK_GUARD
-                if( mpContent->mpVariables == nullptr ) {
-                    mpContent->mpVariables = new Variables(carl::variables(*this).as_set());
-                }
-                return *(mpContent->mpVariables);
+                if( const Variables* vars = mpContent->mVariables.get_if() )
+                    return *vars;
+                detail_visit::traverse( *this,
+                    []( const Formula& sub ) { return sub.mpContent->mVariables.get_if() == nullptr; },
+                    []( const Formula& sub ) {
+                        sub.mpContent->mVariables.get( [&sub]() { return sub.collect_variables(); } );
+                    }
+                );
+                return *mpContent->mVariables.get_if();
             }
 
             Formula negated() const
@@ -0,0 +1,144 @@
+/**
+ * @file FormulaBuilder.h
+ */
+
+#pragma once
+
+#include "Formula.h"
+#include "FormulaPool.h"
+
+#include <algorithm>
+#include <cassert>
+#include <map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace carl
+{
+    /**
+     * Stages a formula DAG without touching the FormulaPool and creates all of its formulas in a single batch.
+     *
+     * Building a large formula bottom-up with the constructors of Formula locks the pool once per subformula,
+     * which contends with other threads creating formulas. The builder only collects the structure of the formulas
+     * and then creates them within one FormulaPool::batch(), which rehashes the pool once in advance for all staged formulas.
+     * Structurally equal staged formulas are shared already while staging.
+     * The created formulas are exactly the ones the constructors of Formula create, including all simplifications.
+     */
+    template<typename Pol>
+    class FormulaBuilder
+    {
+        public:
+            /// Handle of a staged formula.
+            using Node = std::size_t;
+
+        private:
+            /// A staged formula: either already created, an atom or an operator applied to staged formulas.
+            using Entry = std::pair<FormulaType, std::variant<Formula<Pol>, Variable, Constraint<Pol>, std::vector<Node>>>;
+            std::vector<Entry> mEntries;
+            std::map<std::pair<FormulaType, std::vector<Node>>, Node> mOperators;
+            std::map<Variable, Node> mVariables;
+
+            /// Creates the formula of a staged entry, assuming that all entries it depends on are created already.
+            Formula<Pol> create( const Entry& _entry ) const
+            {
+                return std::visit( overloaded {
+                    []( const Formula<Pol>& f ) { return f; },
+                    []( Variable v ) { return Formula<Pol>( v ); },
+                    []( const Constraint<Pol>& c ) { return Formula<Pol>( c ); },
+                    [this, &_entry]( const std::vector<Node>& nodes ) {
+                        if( _entry.first == FormulaType::NOT )
+                        {
+                            assert( nodes.size() == 1 );
+                            return Formula<Pol>( FormulaType::NOT, formula( nodes.front() ) );
+                        }
+                        Formulas<Pol> subformulas;
+                        subformulas.reserve( nodes.size() );
+                        for( Node n: nodes )
+                            subformulas.push_back( formula( n ) );
+                        return Formula<Pol>( _entry.first, std::move( subformulas ) );
+                    }
+                }, _entry.second );
+            }
+
+            const Formula<Pol>& formula( Node _node ) const
+            {
+                assert( std::holds_alternative<Formula<Pol>>( mEntries[_node].second ) );
+                return std::get<Formula<Pol>>( mEntries[_node].second );
+            }
+
+        public:
+            /// Stages an already existing formula.
+            Node add( const Formula<Pol>& _formula )
+            {
+                mEntries.emplace_back( _formula.type(), _formula );
+                return mEntries.size() - 1;
+            }
+
+            /// Stages a boolean variable.
+            Node add( Variable _variable )
+            {
+                auto res = mVariables.emplace( _variable, mEntries.size() );
+                if( res.second )
+                    mEntries.emplace_back( FormulaType::BOOL, _variable );
+                return res.first->second;
+            }
+
+            /// Stages a constraint.
+            Node add( const Constraint<Pol>& _constraint )
+            {
+                mEntries.emplace_back( FormulaType::CONSTRAINT, _constraint );
+                return mEntries.size() - 1;
+            }
+
+            /**
+             * Stages an operator applied to staged formulas.
+             * @param _type The operator, either NOT, IMPLIES, AND, OR, XOR, IFF or ITE.
+             * @param _subformulas The handles of the operands, which must have been returned by this builder.
+             */
+            Node add( FormulaType _type, std::vector<Node> _subformulas )
+            {
+                assert( _type != FormulaType::NOT || _subformulas.size() == 1 );
+                assert( std::all_of( _subformulas.begin(), _subformulas.end(), [this]( Node n ) { return n < mEntries.size(); } ) );
+                auto res = mOperators.emplace( std::make_pair( _type, _subformulas ), mEntries.size() );
+                if( res.second )
+                    mEntries.emplace_back( _type, std::move( _subformulas ) );
+                return res.first->second;
+            }
+
+            /// Stages the negation of a staged formula.
+            Node negation( Node _node )
+            {
+                return add( FormulaType::NOT, { _node } );
+            }
+
+            /// @return The number of staged formulas.
+            std::size_t size() const
+            {
+                return mEntries.size();
+            }
+
+            /**
+             * Creates all staged formulas that have not been created yet, within a single batch of the FormulaPool.
+             * Handles stay valid and formulas can be staged and built again afterwards.
+             * @param _root The handle of the formula to return.
+             * @return The formula of the given handle.
+             */
+            Formula<Pol> build( Node _root )
+            {
+                assert( _root < mEntries.size() );
+                std::size_t staged = std::size_t( std::count_if( mEntries.begin(), mEntries.end(), []( const Entry& entry ) {
+                    return !std::holds_alternative<Formula<Pol>>( entry.second );
+                } ) );
+                FormulaPool<Pol>::getInstance().batch( [this]() {
+                    // Operands are always staged before the formulas using them.
+                    for( auto& entry: mEntries )
+                    {
+                        if( !std::holds_alternative<Formula<Pol>>( entry.second ) )
+                            entry.second = create( entry );
+                    }
+                }, staged );
+                return formula( _root );
+            }
+    };
+}    // namespace carl
@@ -1,7 +1,9 @@
 #pragma once
 
+#include <carl-common/memory/PublishOnce.h>
 #include <carl-logging/carl-logging.h>
 
+#include <atomic>
 #include <iostream>
 #include <variant>
 
@@ -136,9 +138,17 @@ namespace carl {
             /// The unique id.
             size_t mId = 0;
             /// The activity for this formula, which means, how much is this formula involved in the solving procedure.
+            #ifdef THREAD_SAFE
+            mutable std::atomic<double> mActivity{0.0};
+            #else
             mutable double mActivity = 0.0;
+            #endif
             /// The number of formulas existing with this content.
+            #ifdef THREAD_SAFE
+            mutable std::atomic<size_t> mUsages{0};
+            #else
             mutable size_t mUsages = 0;
+            #endif
             /// The type of this formula.
             FormulaType mType;
             /// The content of this formula.
@@ -155,12 +165,8 @@ namespace carl {
             const FormulaContent<Pol> *mNegation = nullptr;
             /// The propositions of this formula.
             Condition mProperties;
-            /// Mutex for access to activity.
-            mutable std::mutex mActivityMutex;
-            /// Mutex for collecting the variables within this formula.
-            mutable std::mutex mVariablesMutex;
             /// Container collecting the variables which occur in this formula.
-            mutable Variables* mpVariables = nullptr;
+            PublishOnce<Variables> mVariables;
             
             FormulaContent() = delete;
             FormulaContent(const FormulaContent&) = delete;
@@ -224,10 +230,7 @@ namespace carl {
             /**
              * Destructor.
              */
-            ~FormulaContent() {
-                if( mpVariables != nullptr )
-                    delete mpVariables;
-            }
+            ~FormulaContent() = default;
 
             std::size_t hash() const {
                 return mHash;
@@ -8,10 +8,14 @@
 #pragma once
 
 #include <carl-common/memory/Singleton.h>
+#include <carl-common/memory/SlabAllocator.h>
 #include <carl-arith/core/VariablePool.h>
+#include <carl-arith/poly/umvpoly/MonomialPool.h>
 #include "Formula.h"
 #include <mutex>
+#include <algorithm>
 #include <limits>
+#include <vector>
 #include <boost/variant.hpp>
 #include "../bitvector/BVConstraintPool.h"
 #include "../bitvector/BVConstraint.h"
@@ -52,6 +56,16 @@ namespace carl
             /// Mutex to avoid multiple access to the pool
             mutable std::recursive_mutex mMutexPool;
 
+            /// Storage for the contents. A content and its negation are always allocated as a pair in a single slot.
+            SlabAllocator<2 * sizeof(FormulaContent<Pol>), alignof(FormulaContent<Pol>)> mContentArena;
+            /// Number of currently running batches, see batch().
+            std::size_t mBatchDepth = 0;
+            /// Number of currently open epochs, see begin_epoch().
+            std::size_t mEpochDepth = 0;
+            /// Set while the destructor destroys the remaining contents.
+            bool mDestroying = false;
+            /// Contents that became unused within an epoch and are erased when the outermost epoch ends.
+            FastPointerSet<FormulaContent<Pol>> mDeferred;
             ///
             FastPointerMap<FormulaContent<Pol>,const FormulaContent<Pol>*> mTseitinVars;
             ///
@@ -92,6 +106,77 @@ namespace carl
                 return mPool.size();
             }
 
+            /**
+             * @return The number of usages of the given formula, including the one of the pool itself.
+             * A formula and its negation share their usages.
+             */
+            std::size_t usages( const Formula<Pol>& _formula ) const
+            {
+                return getBaseFormula( _formula.mpContent )->mUsages;
+            }
+
+            /**
+             * Calls func while holding the pool lock.
+             * This allows to create many formulas without locking the pool for every single one of them, see FormulaBuilder.
+             * The pool is rehashed once in advance for the expected number of new formulas, instead of growing repeatedly while func runs.
+             * @param func Callable without arguments.
+             * @param expected Number of formulas func is expected to add.
+             */
+            template<typename F>
+            void batch( F&& func, std::size_t expected = 0 )
+            {
+                FORMULA_POOL_LOCK_GUARD
+                if( mBatchDepth == 0 && expected > 0 )
+                {
+                    std::size_t buckets = mRehashPolicy.numBucketsFor( mPool.size() + expected );
+                    if( buckets > mPool.bucket_count() )
+                        rehash( buckets );
+                }
+                ++mBatchDepth;
+                func();
+                --mBatchDepth;
+            }
+
+            /**
+             * Opens an epoch. Contents that become unused while an epoch is open are not erased immediately,
+             * but collected when the outermost epoch is closed. Hence temporary formulas that are created and dropped
+             * repeatedly within an epoch (for example by simplifications) are only constructed once.
+             * Epochs may be nested. Use FormulaEpoch to open and close an epoch for a scope.
+             */
+            void begin_epoch()
+            {
+                FORMULA_POOL_LOCK_GUARD
+                ++mEpochDepth;
+            }
+
+            /**
+             * Closes an epoch. If it is the outermost epoch, all contents that are still unused are erased.
+             * @return The number of erased contents.
+             */
+            std::size_t end_epoch()
+            {
+                FORMULA_POOL_LOCK_GUARD
+                assert( mEpochDepth > 0 );
+                if( mEpochDepth > 1 )
+                {
+                    --mEpochDepth;
+                    return 0;
+                }
+                // Erasing a content may release its subformulas, which are deferred as well and collected by this loop.
+                // Contents that were acquired again in the meantime have more than one usage and are kept.
+                std::size_t erased = 0;
+                while( !mDeferred.empty() )
+                {
+                    const FormulaContent<Pol>* tmp = *mDeferred.begin();
+                    mDeferred.erase( mDeferred.begin() );
+                    if( tmp->mUsages == 1 && erase( tmp ) )
+                        ++erased;
+                }
+                mEpochDepth = 0;
+                CARL_LOG_DEBUG("carl.formula", "Erased " << erased << " contents at the end of the epoch");
+                return erased;
+            }
+
             void print() const
             {
                 std::cout << "Formula pool contains:" << std::endl;
@@ -121,6 +206,7 @@ namespace carl
 
             Formula<Pol> getTseitinVar( const Formula<Pol>& _formula )
             {
+                FORMULA_POOL_LOCK_GUARD
                 auto iter = mTseitinVars.find( _formula.mpContent );
                 if( iter != mTseitinVars.end() )
                 {
@@ -131,6 +217,7 @@ namespace carl
 
             Formula<Pol> createTseitinVar( const Formula<Pol>& _formula )
             {
+                FORMULA_POOL_LOCK_GUARD
                 auto iter = mTseitinVars.insert( std::make_pair( _formula.mpContent, nullptr ) );
                 if( iter.second )
                 {
@@ -189,23 +276,49 @@ namespace carl
                 return f;
             }
 
-            FormulaContent<Pol>* createNegatedContent(const FormulaContent<Pol>* f) const {
+            /**
+             * Constructs the negation of f in the given storage.
+             */
+            FormulaContent<Pol>* createNegatedContent(const FormulaContent<Pol>* f, void* storage) const {
                 if (f->mType == FormulaType::CONSTRAINT ||
                     f->mType == FormulaType::VARCOMPARE ||
                     f->mType == FormulaType::VARASSIGN ||
                     f->mType == FormulaType::UEQ) {
                     return std::visit(overloaded {
-                        [](const Constraint<Pol>& a) { return new FormulaContent<Pol>(a.negation()); },
-                        [](const VariableComparison<Pol>& a) { return new FormulaContent<Pol>(a.negation()); },
-                        [](const VariableAssignment<Pol>& a) { return new FormulaContent<Pol>(a.negation()); },
-                        [](const UEquality& a) { return new FormulaContent<Pol>(a.negation()); },
-                        [](const auto&) { assert(false); return new FormulaContent<Pol>(FormulaType::FALSE); }
+                        [storage](const Constraint<Pol>& a) { return new (storage) FormulaContent<Pol>(a.negation()); },
+                        [storage](const VariableComparison<Pol>& a) { return new (storage) FormulaContent<Pol>(a.negation()); },
+                        [storage](const VariableAssignment<Pol>& a) { return new (storage) FormulaContent<Pol>(a.negation()); },
+                        [storage](const UEquality& a) { return new (storage) FormulaContent<Pol>(a.negation()); },
+                        [storage](const auto&) { assert(false); return new (storage) FormulaContent<Pol>(FormulaType::FALSE); }
                     }, f->mContent);
 				} else {
-                    return new FormulaContent<Pol>(NOT, std::move(Formula<Pol>(f)));
+                    return new (storage) FormulaContent<Pol>(NOT, std::move(Formula<Pol>(f)));
                 }
             }
 
+            /**
+             * Allocates storage for a content and its negation.
+             * @return The storage of the content, the negation is stored directly behind it.
+             */
+            FormulaContent<Pol>* allocatePair()
+            {
+                return static_cast<FormulaContent<Pol>*>(mContentArena.allocate());
+            }
+
+            /**
+             * Destroys a content and its negation and releases their storage.
+             */
+            void destroyPair( const FormulaContent<Pol>* _content )
+            {
+                const FormulaContent<Pol>* negation = _content->mNegation;
+                const FormulaContent<Pol>* first = std::less<const FormulaContent<Pol>*>()( _content, negation ) ? _content : negation;
+                mDeferred.erase( _content );
+                mDeferred.erase( negation );
+                negation->~FormulaContent<Pol>();
+                _content->~FormulaContent<Pol>();
+                mContentArena.deallocate( const_cast<FormulaContent<Pol>*>( first ) );
+            }
+
             // ##### Core Theory
 
             /**
@@ -459,38 +572,62 @@ namespace carl
 
             void free( const FormulaContent<Pol>* _elem )
             {
-                FORMULA_POOL_LOCK_GUARD
+                if( mDestroying ) return;
                 const FormulaContent<Pol>* tmp = getBaseFormula(_elem);
 				assert(tmp == getBaseFormula(tmp));
 				assert(isBaseFormula(tmp));
+                #ifdef THREAD_SAFE
+                // As long as the content stays in use, the usage counter is decreased without locking the pool.
+                // Only dropping to a single usage (which is held by the pool itself) may erase the content, which is done under the lock.
+                size_t usages = tmp->mUsages.load(std::memory_order_relaxed);
+                while( usages > 2 )
+                {
+                    if( tmp->mUsages.compare_exchange_weak( usages, usages - 1, std::memory_order_acq_rel, std::memory_order_relaxed ) )
+                    {
+                        CARL_LOG_TRACE("carl.formula", "Usage of " << static_cast<const void*>(tmp) << " / " << static_cast<const void*>(tmp->mNegation) << " (coming from " << static_cast<const void*>(_elem) << "): " << (usages - 1));
+                        return;
+                    }
+                }
+                #endif
+                FORMULA_POOL_LOCK_GUARD
                 assert( tmp->mUsages > 0 );
-                --tmp->mUsages;
-				CARL_LOG_TRACE("carl.formula", "Usage of " << static_cast<const void*>(tmp) << " / " << static_cast<const void*>(tmp->mNegation) << " (coming from " << static_cast<const void*>(_elem) << "): " << tmp->mUsages);
-                if( tmp->mUsages == 1 )
+                size_t remaining = --tmp->mUsages;
+				CARL_LOG_TRACE("carl.formula", "Usage of " << static_cast<const void*>(tmp) << " / " << static_cast<const void*>(tmp->mNegation) << " (coming from " << static_cast<const void*>(_elem) << "): " << remaining);
+                if( remaining == 1 )
                 {
-					CARL_LOG_DEBUG("carl.formula", "Actually freeing " << *tmp << " from pool");
-                    bool stillStoredAsTseitinVariable = false;
-                    if( freeTseitinVariable( tmp ) )
-                        stillStoredAsTseitinVariable = true;
-                    if( freeTseitinVariable( tmp->mNegation ) )
-                        stillStoredAsTseitinVariable = true;
-                    if( !stillStoredAsTseitinVariable )
+                    if( mEpochDepth > 0 )
                     {
-						CARL_LOG_TRACE("carl.formula", "Deleting " << tmp << " / " << tmp->mNegation << " from pool");
-                        
-                        //auto it = mPool.find(*tmp->mNegation);
-                        //assert(it != mPool.end());
-                        //mPool.erase(it);
-                        assert(mPool.find(*tmp->mNegation) == mPool.end());
-                        auto it = mPool.find(*tmp);
-                        assert(it != mPool.end());
-                        mPool.erase(it);
-                        delete tmp->mNegation;
-                        delete tmp;
+                        CARL_LOG_TRACE("carl.formula", "Deferring " << static_cast<const void*>(tmp) << " to the end of the epoch");
+                        mDeferred.insert( tmp );
+                        return;
                     }
+                    erase( tmp );
                 }
             }
 
+            /**
+             * Erases an unused content and its negation from the pool, unless it is still stored as a Tseitin variable.
+             * @return True, if the content was erased.
+             */
+            bool erase( const FormulaContent<Pol>* tmp )
+            {
+				CARL_LOG_DEBUG("carl.formula", "Actually freeing " << *tmp << " from pool");
+                bool stillStoredAsTseitinVariable = false;
+                if( freeTseitinVariable( tmp ) )
+                    stillStoredAsTseitinVariable = true;
+                if( freeTseitinVariable( tmp->mNegation ) )
+                    stillStoredAsTseitinVariable = true;
+                if( stillStoredAsTseitinVariable )
+                    return false;
+				CARL_LOG_TRACE("carl.formula", "Deleting " << tmp << " / " << tmp->mNegation << " from pool");
+                assert(mPool.find(*tmp->mNegation) == mPool.end());
+                auto it = mPool.find(*tmp);
+                assert(it != mPool.end());
+                mPool.erase(it);
+                destroyPair( tmp );
+                return true;
+            }
+
             bool freeTseitinVariable( const FormulaContent<Pol>* _toDelete )
             {
                 bool stillStoredAsTseitinVariable = false;
@@ -507,8 +644,7 @@ namespace carl
                         mTseitinVarToFormula.erase( tmp );
 						CARL_LOG_TRACE("carl.formula", "Deleting " << static_cast<const void*>(tmp) << " / " << static_cast<const void*>(tmp->mNegation) << " from pool");
                         mPool.erase( *tmp );
-                        delete tmp->mNegation;
-                        delete tmp;
+                        destroyPair( tmp );
                     }
                     else // the tseitin variable is used, so we cannot delete the formula
                         stillStoredAsTseitinVariable = true;
@@ -529,8 +665,7 @@ namespace carl
                             mTseitinVarToFormula.erase( tmpTVIter );
 							CARL_LOG_TRACE("carl.formula", "Deleting " << static_cast<const void*>(tmp) << " / " << static_cast<const void*>(tmp->mNegation) << " from pool");
                             mPool.erase( *tmp );
-                            delete tmp->mNegation;
-                            delete tmp;
+                            destroyPair( tmp );
                         }
                         else // the formula is used, so we cannot delete the tseitin variable
                             stillStoredAsTseitinVariable = true;
@@ -539,19 +674,39 @@ namespace carl
                 return stillStoredAsTseitinVariable;
             }
 
-            void reg( const FormulaContent<Pol>* _elem ) const
+            /**
+             * Creates a content like create() and registers a usage of it before the pool lock is released.
+             * A content returned by add() may only be held by the pool itself. If it was registered after releasing the lock,
+             * another thread (or the end of an epoch) could erase it in between.
+             * @return The created content, whose usage is owned by the caller.
+             */
+            template<typename... Args>
+            const FormulaContent<Pol>* acquire( Args&&... _args )
             {
                 FORMULA_POOL_LOCK_GUARD
+                const FormulaContent<Pol>* res = create( std::forward<Args>( _args )... );
+                if( res != nullptr )
+                    reg( res );
+                return res;
+            }
+
+            /**
+             * Registers a new usage of the given content.
+             * This never locks the pool. Hence the caller must either hold a usage of the content already or hold the pool lock,
+             * otherwise the content could be erased concurrently.
+             */
+            void reg( const FormulaContent<Pol>* _elem ) const
+            {
                 const FormulaContent<Pol>* tmp = getBaseFormula(_elem);
                 //const FormulaContent<Pol>* tmp = _elem->mType == FormulaType::NOT ? _elem->mNegation : _elem;
                 assert( tmp != nullptr );
                 assert( tmp->mUsages < std::numeric_limits<size_t>::max() );
-                ++tmp->mUsages;
-                if (tmp->mUsages == 1 && (tmp->mType == FormulaType::CONSTRAINT || tmp->mType == FormulaType::UEQ || tmp->mType == FormulaType::VARCOMPARE || tmp->mType == FormulaType::VARASSIGN)) {
+                size_t usages = ++tmp->mUsages;
+                if (usages == 1 && (tmp->mType == FormulaType::CONSTRAINT || tmp->mType == FormulaType::UEQ || tmp->mType == FormulaType::VARCOMPARE || tmp->mType == FormulaType::VARASSIGN)) {
                     CARL_LOG_TRACE("carl.formula", "Is a constraint, increasing again");
-                    ++tmp->mUsages;
+                    usages = ++tmp->mUsages;
                 }
-				CARL_LOG_TRACE("carl.formula", "Increased usage of " << static_cast<const void*>(tmp) << " / " << static_cast<const void*>(tmp->mNegation) << "(based on " << static_cast<const void*>(_elem) << ")" << " to " << tmp->mUsages);
+				CARL_LOG_TRACE("carl.formula", "Increased usage of " << static_cast<const void*>(tmp) << " / " << static_cast<const void*>(tmp->mNegation) << "(based on " << static_cast<const void*>(_elem) << ")" << " to " << usages);
             }
 
         public:
@@ -595,16 +750,39 @@ namespace carl
              */
             const FormulaContent<Pol>* add( FormulaContent<Pol>&& _formula );
 
+            void rehash(std::size_t buckets) {
+                auto new_buckets = new typename underlying_set::bucket_type[buckets];
+                mPool.rehash(typename underlying_set::bucket_traits(new_buckets, buckets));
+                mPoolBuckets.reset(new_buckets);
+            }
+
             void check_rehash() {
                 auto rehash = mRehashPolicy.needRehash(mPool.bucket_count(), mPool.size());
                 if (rehash.first) {
-                    auto new_buckets = new typename underlying_set::bucket_type[rehash.second];
-                    mPool.rehash(typename underlying_set::bucket_traits(new_buckets, rehash.second));
-                    mPoolBuckets.reset(new_buckets);
+                    this->rehash(rehash.second);
                 }
             }
 
     };
+
+    /**
+     * Opens an epoch of the formula pool for the lifetime of this object, see FormulaPool::begin_epoch().
+     */
+    template<typename Pol>
+    class FormulaEpoch
+    {
+        public:
+            FormulaEpoch()
+            {
+                FormulaPool<Pol>::getInstance().begin_epoch();
+            }
+            FormulaEpoch(const FormulaEpoch&) = delete;
+            FormulaEpoch& operator=(const FormulaEpoch&) = delete;
+            ~FormulaEpoch()
+            {
+                FormulaPool<Pol>::getInstance().end_epoch();
+            }
+    };
 }    // namespace carl
 
 #include "FormulaPool.tpp"
@@ -21,8 +21,11 @@ namespace carl
         mTseitinVarToFormula()
     {
 		VariablePool::getInstance();
-        mpTrue = new FormulaContent<Pol>( TRUE, 1 );
-        mpFalse = new FormulaContent<Pol>( FALSE, 2 );
+        // The contents are destroyed with the pool and free their monomials, hence the monomial pool has to outlive this pool.
+        MonomialPool::getInstance();
+        FormulaContent<Pol>* storage = allocatePair();
+        mpTrue = new (storage) FormulaContent<Pol>( TRUE, 1 );
+        mpFalse = new (storage + 1) FormulaContent<Pol>( FALSE, 2 );
         mpTrue->mNegation = mpFalse;
      	mpFalse->mNegation = mpTrue;
         mPool.insert( *mpTrue );
@@ -36,10 +39,24 @@ namespace carl
     template<typename Pol>
     FormulaPool<Pol>::~FormulaPool()
     {
-        // assert( mPool.size() == 2 );
+        // Destroy all contents that are still alive before their slabs are released.
+        // Subformulas are destroyed along with their parents in arbitrary order, hence free() ignores them from now on.
+        mDestroying = true;
+        std::vector<const FormulaContent<Pol>*> pairs;
+        pairs.reserve( mPool.size() );
+        for( const FormulaContent<Pol>& content : mPool )
+        {
+            pairs.push_back( std::min( &content, content.mNegation, std::less<const FormulaContent<Pol>*>() ) );
+        }
         mPool.clear();
-        delete mpTrue;
-        delete mpFalse;
+        // TRUE and FALSE are both in the pool, but share a pair.
+        std::sort( pairs.begin(), pairs.end(), std::less<const FormulaContent<Pol>*>() );
+        pairs.erase( std::unique( pairs.begin(), pairs.end() ), pairs.end() );
+        for( const FormulaContent<Pol>* content : pairs )
+        {
+            destroyPair( content );
+        }
+        assert( mContentArena.size() == 0 );
     }
     
     template<typename Pol>
@@ -52,7 +69,8 @@ namespace carl
 	    auto res = mPool.insert_check(_element, /*content_hash(), content_equal(),*/ insert_data);
         if( res.second ) // Formula has not yet been generated.
         {
-            auto cont = new FormulaContent<Pol>(std::move(_element));
+            FormulaContent<Pol>* storage = allocatePair();
+            auto cont = new (storage) FormulaContent<Pol>(std::move(_element));
 			// Add also the negation of the formula to the pool in order to ensure that it
             // has the next id and hence would occur next to the formula in a set of sub-formula,
             // which is sorted by the ids. 
@@ -60,9 +78,9 @@ namespace carl
             Formula<Pol>::init( *cont );
             ++mIdAllocator;
             mPool.insert_commit(*cont, insert_data);
-		    check_rehash();
+            check_rehash();
 
-            auto negation = createNegatedContent(cont);
+            auto negation = createNegatedContent(cont, storage + 1);
             cont->mNegation = negation;
             negation->mId = mIdAllocator; 
             negation->mNegation = cont;
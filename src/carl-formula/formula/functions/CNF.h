@@ -5,6 +5,10 @@
 #include "Negations.h"
 #include "aux.h"
 
+#include <atomic>
+#include <mutex>
+#include <thread>
+
 namespace carl {
 namespace formula_to_cnf {
 
@@ -29,8 +33,7 @@ std::vector<Formula<Poly>> construct_iff(const Formula<Poly>& lhs, const std::ve
 
 template<typename Poly>
 using TseitinConstraints = std::vector<Formula<Poly>>;
-template<typename Poly>
-using ConstraintBounds = FastMap<Poly, std::map<typename Poly::NumberType, std::pair<Relation,Formula<Poly>>>>;
+using carl::ConstraintBounds;
 
 /**
  * Converts an OR to cnf.
@@ -156,30 +159,37 @@ Formula<Poly> to_cnf_or(const Formula<Poly>& f, bool keep_constraints, bool simp
 }
 
 /**
- * Converts the given formula to CNF.
+ * Converts the given formula to CNF and passes every clause to the sink as soon as it has been constructed.
+ * In contrast to to_cnf(), the conjunction of all clauses is never constructed, which avoids interning a huge formula in the FormulaPool.
+ * The clauses are passed in the same order as they occur in the result of to_cnf().
  * @param f Formula to convert.
+ * @param sink Callable that is called with every clause, i.e. with a literal or a disjunction of literals.
  * @param keep_constraints Indicates whether to keep constraints or allow to change them in resolve_negation().
  * @param simplify_combinations Indicates whether we attempt to simplify combinations of constraints with ConstraintBounds.
  * @param tseitin_equivalence Indicates whether we use implications or equivalences for tseitin variables.
- * @return The formula in CNF.
+ * @return False, if the formula was found to be equivalent to false. The clauses passed to the sink so far should be dropped in this case.
  */
-template<typename Poly>
-Formula<Poly> to_cnf(const Formula<Poly>& f, bool keep_constraints = true, bool simplify_combinations = false, bool tseitin_equivalence = true) {
-	if (!simplify_combinations && f.property_holds(PROP_IS_IN_CNF)) {
-		if (keep_constraints) {
-			return f;
-		} else if (f.type() == FormulaType::NOT) {
-			assert(f.is_literal());
-			return resolve_negation(f,keep_constraints);
+template<typename Poly, typename Sink>
+bool to_cnf_clauses(const Formula<Poly>& f, Sink&& sink, bool keep_constraints = true, bool simplify_combinations = false, bool tseitin_equivalence = true) {
+	if (!simplify_combinations && keep_constraints && f.property_holds(PROP_IS_IN_CNF)) {
+		switch (f.type()) {
+			case FormulaType::TRUE:
+				return true;
+			case FormulaType::FALSE:
+				return false;
+			case FormulaType::AND:
+				for (const auto& sub: f.subformulas()) {
+					sink(sub);
+				}
+				return true;
+			default:
+				sink(f);
+				return true;
 		}
-	} else if (f.is_atom()) {
-		return f;
 	}
 
 	// Checks for immediate conflicts among constraints
 	formula_to_cnf::ConstraintBounds<Poly> constraint_bounds;
-	// Resulting subformulas
-	Formulas<Poly> subformulas;
 	// Queue of subformulas to process
 	std::vector<Formula<Poly>> subformula_queue = { f };
 	while (!subformula_queue.empty()) {
@@ -191,30 +201,30 @@ Formula<Poly> to_cnf(const Formula<Poly>& f, bool keep_constraints = true, bool
 			case FormulaType::TRUE:
 				break;
 			case FormulaType::FALSE:
-				return Formula<Poly>(FormulaType::FALSE);
+				return false;
 			case FormulaType::BITVECTOR:
 			case FormulaType::BOOL:
 			case FormulaType::UEQ:
 			case FormulaType::VARASSIGN:
 			case FormulaType::VARCOMPARE:
-				subformulas.emplace_back(current);
+				sink(current);
 				break;
 			case FormulaType::CONSTRAINT:
 				// Try simplification with ConstraintBounds
 				if (simplify_combinations) {
 					if (addConstraintBound(constraint_bounds, current, true).is_false()) {
 						CARL_LOG_DEBUG("carl.formula.cnf", "Adding " << current << " to constraint bounds yielded a conflict");
-						return Formula<Poly>(FormulaType::FALSE);
+						return false;
 					}
 				} else {
-					subformulas.emplace_back(current);
+					sink(current);
 				}
 				break;
 			case FormulaType::NOT: {
 				// Resolve negation
 				auto resolved = resolve_negation(current, keep_constraints);
 				if (resolved.is_literal()) {
-					subformulas.emplace_back(resolved);
+					sink(resolved);
 				} else {
 					subformula_queue.emplace_back(resolved);
 				}
@@ -283,10 +293,12 @@ Formula<Poly> to_cnf(const Formula<Poly>& f, bool keep_constraints = true, bool
 				formula_to_cnf::TseitinConstraints<Poly> tseitin;
 				auto res = formula_to_cnf::to_cnf_or(current, keep_constraints, simplify_combinations, tseitin_equivalence, tseitin);
 				if (res.is_false()) {
-					return Formula<Poly>(FormulaType::FALSE);
+					return false;
 				}
 				subformula_queue.insert(subformula_queue.end(), tseitin.begin(), tseitin.end());
-				subformulas.emplace_back(res);
+				if (!res.is_true()) {
+					sink(res);
+				}
 				break;
 			}
 			case FormulaType::EXISTS:
@@ -296,7 +308,89 @@ Formula<Poly> to_cnf(const Formula<Poly>& f, bool keep_constraints = true, bool
 				break;
 		}
 	}
-	if (simplify_combinations && swapConstraintBounds(constraint_bounds, subformulas, true)) {
+	if (simplify_combinations) {
+		Formulas<Poly> bounds;
+		if (swapConstraintBounds(constraint_bounds, bounds, true)) {
+			return false;
+		}
+		for (const auto& b: bounds) {
+			sink(b);
+		}
+	}
+	return true;
+}
+
+/**
+ * Converts the given formula to CNF like to_cnf_clauses(), but converts the top-level conjuncts of the formula on multiple worker threads.
+ * The sink is called by one thread at a time, but the order of the clauses is unspecified.
+ * Constraint bounds are only combined within every conjunct.
+ * As the FormulaPool is only synchronized if carl is built with THREAD_SAFE, the conversion is sequential otherwise.
+ * @param num_threads Maximum number of worker threads.
+ */
+template<typename Poly, typename Sink>
+bool to_cnf_clauses_parallel(const Formula<Poly>& f, Sink&& sink, std::size_t num_threads, bool keep_constraints = true, bool simplify_combinations = false, bool tseitin_equivalence = true) {
+	#ifndef THREAD_SAFE
+	if (num_threads > 1) {
+		CARL_LOG_WARN("carl.formula.cnf", "Parallel CNF conversion requires THREAD_SAFE, converting sequentially.");
+		num_threads = 1;
+	}
+	#endif
+	if (f.type() != FormulaType::AND) {
+		num_threads = 1;
+	} else {
+		num_threads = std::min(num_threads, f.size());
+	}
+	if (num_threads <= 1) {
+		return to_cnf_clauses(f, sink, keep_constraints, simplify_combinations, tseitin_equivalence);
+	}
+	const auto& conjuncts = f.subformulas();
+	std::atomic<std::size_t> next(0);
+	std::atomic<bool> satisfiable(true);
+	std::mutex sink_mutex;
+	auto locked_sink = [&sink, &sink_mutex](const Formula<Poly>& clause) {
+		std::lock_guard<std::mutex> lock(sink_mutex);
+		sink(clause);
+	};
+	std::vector<std::thread> workers;
+	for (std::size_t t = 0; t < num_threads; ++t) {
+		workers.emplace_back([&]() {
+			for (std::size_t i = next++; i < conjuncts.size() && satisfiable; i = next++) {
+				if (!to_cnf_clauses(conjuncts[i], locked_sink, keep_constraints, simplify_combinations, tseitin_equivalence)) {
+					satisfiable = false;
+				}
+			}
+		});
+	}
+	for (auto& w: workers) {
+		w.join();
+	}
+	return satisfiable;
+}
+
+/**
+ * Converts the given formula to CNF.
+ * @param f Formula to convert.
+ * @param keep_constraints Indicates whether to keep constraints or allow to change them in resolve_negation().
+ * @param simplify_combinations Indicates whether we attempt to simplify combinations of constraints with ConstraintBounds.
+ * @param tseitin_equivalence Indicates whether we use implications or equivalences for tseitin variables.
+ * @return The formula in CNF.
+ */
+template<typename Poly>
+Formula<Poly> to_cnf(const Formula<Poly>& f, bool keep_constraints = true, bool simplify_combinations = false, bool tseitin_equivalence = true) {
+	if (!simplify_combinations && f.property_holds(PROP_IS_IN_CNF)) {
+		if (keep_constraints) {
+			return f;
+		} else if (f.type() == FormulaType::NOT) {
+			assert(f.is_literal());
+			return resolve_negation(f,keep_constraints);
+		}
+	} else if (f.is_atom()) {
+		return f;
+	}
+
+	Formulas<Poly> subformulas;
+	auto collect = [&subformulas](const Formula<Poly>& clause) { subformulas.emplace_back(clause); };
+	if (!to_cnf_clauses(f, collect, keep_constraints, simplify_combinations, tseitin_equivalence)) {
 		return Formula<Poly>(FormulaType::FALSE);
 	} else if (subformulas.empty()) {
 		return Formula<Poly>(FormulaType::TRUE);
@@ -306,4 +400,4 @@ Formula<Poly> to_cnf(const Formula<Poly>& f, bool keep_constraints = true, bool
 	return Formula<Poly>(FormulaType::AND, std::move(subformulas));
 }
 
-}
\ No newline at end of file
+}
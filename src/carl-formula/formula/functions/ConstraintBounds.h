@@ -2,9 +2,31 @@
 
 namespace carl {
 
-/// A map from formula pointers to a map of rationals to a pair of a constraint relation and a formula pointer. (internally used)
+/// Hashes a constraint by the normalized polynomial it bounds, see NormalizedBound. (internally used)
 template<typename Pol>
-using ConstraintBounds = FastMap<Pol, std::map<typename Pol::NumberType, std::pair<Relation,Formula<Pol>>>> ;
+struct BoundedPolynomialHash {
+    std::size_t operator()( const Constraint<Pol>& _constraint ) const
+    {
+        return _constraint.normalized_bound().hash;
+    }
+};
+
+/// Compares constraints by the normalized polynomial they bound, see NormalizedBound. (internally used)
+template<typename Pol>
+struct BoundedPolynomialEqual {
+    bool operator()( const Constraint<Pol>& _lhs, const Constraint<Pol>& _rhs ) const
+    {
+        return _lhs == _rhs || _lhs.normalized_bound().poly == _rhs.normalized_bound().poly;
+    }
+};
+
+/**
+ * A map from constraints, identified by the normalized polynomial they bound, to a map of rationals to a pair of a constraint
+ * relation and a formula. The key is the first constraint found for a polynomial, hence neither copying nor hashing a
+ * polynomial is necessary. (internally used)
+ */
+template<typename Pol>
+using ConstraintBounds = std::unordered_map<Constraint<Pol>, std::map<typename Pol::NumberType, std::pair<Relation,Formula<Pol>>>, BoundedPolynomialHash<Pol>, BoundedPolynomialEqual<Pol>>;
 
 //    #define CONSTRAINT_BOUND_DEBUG
 
@@ -31,30 +53,16 @@ Formula<Pol> addConstraintBound( ConstraintBounds<Pol>& _constraintBounds, const
     assert( _constraint.type() == FormulaType::CONSTRAINT || (negated && _constraint.subformula().type() == FormulaType::CONSTRAINT ) );
     const Constraint<Pol>& constraint = negated ? _constraint.subformula().constraint() : _constraint.constraint();
     assert( constraint.is_consistent() == 2 );
-    typename Pol::NumberType boundValue;
-    Relation relation = negated ? carl::inverse( constraint.relation() ) : constraint.relation();
+    // The normalization is cached in the constraint pool, hence no polynomial arithmetic is needed here.
+    const NormalizedBound<Pol>& normalized = constraint.normalized_bound();
+    const typename Pol::NumberType& boundValue = normalized.bound;
+    Relation relation = negated ? carl::inverse( normalized.relation ) : normalized.relation;
     const Pol& lhs = constraint.lhs();
-    Pol poly;
-    bool multipliedByMinusOne = lhs.lterm().coeff() < typename Pol::NumberType( 0 );
-    if( multipliedByMinusOne )
-    {
-        boundValue = constraint.lhs().constant_part();
-        relation = carl::turn_around( relation );
-        poly = Pol( -lhs + boundValue );
-    }
-    else
-    {
-        boundValue = -constraint.lhs().constant_part();
-        poly = Pol( lhs + boundValue );
-    }
-    typename Pol::NumberType cf( poly.coprime_factor() );
-    assert( cf > 0 );
-    boundValue *= cf;
-    poly *= cf;
+    bool multipliedByMinusOne = normalized.turned;
     #ifdef CONSTRAINT_BOUND_DEBUG
-    std::cout << "try to add the bound  " << relation << boundValue << "  for the polynomial  " << poly << std::endl;
+    std::cout << "try to add the bound  " << relation << boundValue << "  for the polynomial  " << normalized.poly << std::endl;
     #endif
-    auto resA = _constraintBounds.insert( std::make_pair( std::move(poly), std::move( std::map<typename Pol::NumberType, std::pair<Relation, Formula<Pol>>>() ) ) );
+    auto resA = _constraintBounds.try_emplace( constraint );
     auto resB = resA.first->second.insert( std::make_pair( boundValue, std::make_pair( relation, _constraint ) ) );
     if( resB.second || resB.first->second.first == relation )
         return resB.first->second.second;
@@ -333,7 +341,7 @@ bool swapConstraintBounds( ConstraintBounds<Pol>& _constraintBounds, Formulas<Po
     while( !_constraintBounds.empty() )
     {
         #ifdef CONSTRAINT_BOUND_DEBUG
-        std::cout << "for the bounds of  " << _constraintBounds.begin()->first << std::endl;
+        std::cout << "for the bounds of  " << _constraintBounds.begin()->first.normalized_bound().poly << std::endl;
         #endif
         const std::map<typename Pol::NumberType, std::pair<Relation, Formula<Pol>>>& bounds = _constraintBounds.begin()->second;
         assert( !bounds.empty() );
@@ -3,6 +3,11 @@
 #include "../Formula.h"
 #include "Visit.h"
 
+#include <carl-common/util/hash.h>
+
+#include <functional>
+#include <unordered_map>
+
 namespace carl {
 
 namespace helper {
@@ -19,11 +24,19 @@ namespace helper {
 
 	template<typename Pol>
 	struct PolynomialSubstitutor {
-		const std::map<Variable,typename Formula<Pol>::PolynomialType>& replacements;
-		explicit PolynomialSubstitutor(const std::map<Variable,typename Formula<Pol>::PolynomialType>& repl): replacements(repl) {}
+		using Poly = typename Formula<Pol>::PolynomialType;
+		const std::map<Variable,Poly>& replacements;
+		/// Results for the left-hand sides of constraints, which are shared by a constraint and its negation.
+		std::unordered_map<Poly,Poly>& polynomials;
+		PolynomialSubstitutor(const std::map<Variable,Poly>& repl, std::unordered_map<Poly,Poly>& polys): replacements(repl), polynomials(polys) {}
 		Formula<Pol> operator()(const Formula<Pol>& formula) {
 			if (formula.type() != FormulaType::CONSTRAINT) return formula;
-			return Formula<Pol>(carl::substitute(formula.constraint().lhs(), replacements), formula.constraint().relation());
+			const Poly& lhs = formula.constraint().lhs();
+			auto it = polynomials.find(lhs);
+			if (it == polynomials.end()) {
+				it = polynomials.emplace(lhs, carl::substitute(lhs, replacements)).first;
+			}
+			return Formula<Pol>(it->second, formula.constraint().relation());
 		}
 	};
 
@@ -61,10 +74,75 @@ Formula<Pol> substitute(const Formula<Pol>& formula, const std::map<Formula<Pol>
 	helper::Substitutor<Pol> subs(replacements);
 	return visit_result(formula, std::function<Formula<Pol>(Formula<Pol>)>(subs));
 }
+/**
+ * Caches the results of substituting polynomials into formulas across multiple calls of substitute().
+ * For every substitution, the results for all subformulas and for the left-hand sides of all constraints are stored,
+ * such that substituting the same (or an overlapping) formula with the same substitution again does not substitute into any polynomial again.
+ * The cache is never cleared automatically, use clear() to free the memory.
+ */
+template<typename Pol>
+class SubstitutionCache {
+public:
+	using Poly = typename Formula<Pol>::PolynomialType;
+	using Replacements = std::map<Variable,Poly>;
+	/// The memoized results for a single substitution.
+	struct Memo {
+		Replacements replacements;
+		std::unordered_map<std::size_t, Formula<Pol>> formulas;
+		std::unordered_map<Poly,Poly> polynomials;
+	};
+private:
+	/// Memo tables indexed by the hash of the substitution.
+	std::unordered_map<std::size_t, std::vector<Memo>> mMemos;
+
+	static std::size_t hash(const Replacements& replacements) {
+		std::size_t res = 0;
+		for (const auto& r: replacements) {
+			carl::hash_add(res, r.first, r.second);
+		}
+		return res;
+	}
+public:
+	/// @return The memo table for the given substitution.
+	Memo& memo(const Replacements& replacements) {
+		auto& bucket = mMemos[hash(replacements)];
+		for (auto& m: bucket) {
+			if (m.replacements == replacements) return m;
+		}
+		bucket.push_back(Memo{ replacements, {}, {} });
+		return bucket.back();
+	}
+	/// @return The number of cached formula results.
+	std::size_t size() const {
+		std::size_t res = 0;
+		for (const auto& bucket: mMemos) {
+			for (const auto& m: bucket.second) res += m.formulas.size();
+		}
+		return res;
+	}
+	void clear() {
+		mMemos.clear();
+	}
+};
+
+/**
+ * Substitutes variables by polynomials in all constraints of the formula.
+ * Every distinct subformula and every distinct left-hand side of a constraint is only substituted once.
+ */
 template<typename Pol>
 Formula<Pol> substitute(const Formula<Pol>& formula, const std::map<Variable,typename Formula<Pol>::PolynomialType>& replacements) {
-	helper::PolynomialSubstitutor<Pol> subs(replacements);
-	return visit_result(formula, std::function<Formula<Pol>(Formula<Pol>)>(subs));
+	std::unordered_map<typename Formula<Pol>::PolynomialType, typename Formula<Pol>::PolynomialType> polynomials;
+	helper::PolynomialSubstitutor<Pol> subs(replacements, polynomials);
+	return visit_result(formula, std::ref(subs));
+}
+/**
+ * Substitutes variables by polynomials in all constraints of the formula, reusing and extending the results stored in the given cache.
+ */
+template<typename Pol>
+Formula<Pol> substitute(const Formula<Pol>& formula, const std::map<Variable,typename Formula<Pol>::PolynomialType>& replacements, SubstitutionCache<Pol>& cache) {
+	auto& memo = cache.memo(replacements);
+	helper::PolynomialSubstitutor<Pol> subs(memo.replacements, memo.polynomials);
+	return visit_result(formula, std::ref(subs), memo.formulas);
 }
 template<typename Pol>
 Formula<Pol> substitute(const Formula<Pol>& formula, const std::map<BVVariable,BVTerm>& replacements) {
@@ -1,15 +1,19 @@
 #pragma once
 
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
 namespace carl {
 
+namespace detail_visit {
 
 /**
- * Recursively calls func on every subformula.
- * @param formula Formula to visit.
- * @param func Function to call.
+ * Pushes the direct subformulas of formula onto the stack in reverse order, such that they are popped in their original order.
  */
-template<typename Pol, typename Visitor>
-void visit(const Formula<Pol>& formula, /*std::function<void(const Formula<Pol>&)>&*/ Visitor func) {
+template<typename Pol>
+void push_subformulas(const Formula<Pol>& formula, std::vector<std::pair<Formula<Pol>, bool>>& stack) {
 	switch (formula.type()) {
 		case AND:
 		case OR:
@@ -17,10 +21,12 @@ void visit(const Formula<Pol>& formula, /*std::function<void(const Formula<Pol>&
 		case XOR:
 		case IMPLIES:
 		case ITE:
-			for (const auto& cur: formula.subformulas()) visit(cur, func);
+			for (auto it = formula.subformulas().rbegin(); it != formula.subformulas().rend(); ++it) {
+				stack.emplace_back(*it, false);
+			}
 			break;
 		case NOT:
-			visit(formula.subformula(), func);
+			stack.emplace_back(formula.subformula(), false);
 			break;
 		case BOOL:
 		case CONSTRAINT:
@@ -33,82 +39,172 @@ void visit(const Formula<Pol>& formula, /*std::function<void(const Formula<Pol>&
 			break;
 		case EXISTS:
 		case FORALL:
-			visit(formula.quantified_formula(), func);
+			stack.emplace_back(formula.quantified_formula(), false);
 			break;
 	}
-	func(formula);
 }
+
+/**
+ * Traverses formula in post-order without recursion.
+ * Every stack entry is visited twice: first its subformulas are pushed, then func is called.
+ * @param formula Formula to traverse.
+ * @param enter Called before the subformulas of a formula are pushed. If it returns false, the formula is skipped entirely.
+ * @param leave Called after all subformulas of a formula have been left.
+ */
+template<typename Pol, typename Enter, typename Leave>
+void traverse(const Formula<Pol>& formula, Enter&& enter, Leave&& leave) {
+	std::vector<std::pair<Formula<Pol>, bool>> stack;
+	stack.emplace_back(formula, false);
+	while (!stack.empty()) {
+		if (stack.back().second) {
+			Formula<Pol> cur = std::move(stack.back().first);
+			stack.pop_back();
+			leave(cur);
+			continue;
+		}
+		if (!enter(stack.back().first)) {
+			stack.pop_back();
+			continue;
+		}
+		stack.back().second = true;
+		Formula<Pol> cur = stack.back().first;
+		push_subformulas(cur, stack);
+	}
+}
+
+}
+
 /**
- * Recursively calls func on every subformula and return a new formula.
+ * Calls func on every occurrence of every subformula, subformulas before the formulas containing them.
+ * Shared subformulas are visited once per occurrence. Use visit_dag() if func only needs to see every distinct subformula once.
+ * @param formula Formula to visit.
+ * @param func Function to call.
+ */
+template<typename Pol, typename Visitor>
+void visit(const Formula<Pol>& formula, /*std::function<void(const Formula<Pol>&)>&*/ Visitor func) {
+	detail_visit::traverse(formula,
+		[](const Formula<Pol>&) { return true; },
+		[&func](const Formula<Pol>& f) { func(f); }
+	);
+}
+
+/**
+ * Calls func once on every distinct subformula, subformulas before the formulas containing them.
+ * As formulas are hash-consed in the FormulaPool, a formula is a DAG whose size may be exponentially smaller than its tree.
+ * This traversal takes linear time in the size of the DAG.
+ * @param formula Formula to visit.
+ * @param func Function to call.
+ */
+template<typename Pol, typename Visitor>
+void visit_dag(const Formula<Pol>& formula, Visitor func) {
+	std::unordered_set<std::size_t> visited;
+	detail_visit::traverse(formula,
+		[&visited](const Formula<Pol>& f) { return visited.find(f.id()) == visited.end(); },
+		[&visited, &func](const Formula<Pol>& f) {
+			if (visited.insert(f.id()).second) func(f);
+		}
+	);
+}
+
+/**
+ * Calls func on every subformula and return a new formula.
  * On every call of func, the passed formula is replaced by the result.
+ * The result for every distinct subformula is memoized, hence func must only depend on its argument
+ * and is called once per distinct subformula, which makes this linear in the size of the DAG.
  * @param formula Formula to visit.
  * @param func Function to call.
  * @return New formula.
  */
 template<typename Pol, typename Visitor>
 Formula<Pol> visit_result(const Formula<Pol>& formula, /*std::function<Formula<Pol>(const Formula<Pol>&)>&*/ Visitor func) {
-	Formula<Pol> newFormula = formula;
-	switch (formula.type()) {
-		case AND:
-		case OR:
-		case IFF:
-		case XOR: {
-			Formulas<typename Formula<Pol>::PolynomialType> newSubformulas;
-			bool changed = false;
-			for (const auto& cur: formula.subformulas()) {
-				Formula newCur = visit_result(cur, func);
-				if (newCur != cur) changed = true;
-				newSubformulas.push_back(newCur);
-			}
-			if (changed) {
-				newFormula = Formula(formula.type(), std::move(newSubformulas));
-			}
-			break;
-		}
-		case NOT: {
-			Formula<Pol> cur = visit_result(formula.subformula(), func);
-			if (cur != formula.subformula()) {
-				newFormula = !cur;
-			}
-			break;
-		}
-		case IMPLIES: {
-			Formula<Pol> prem = visit_result(formula.premise(), func);
-			Formula<Pol> conc = visit_result(formula.conclusion(), func);
-			if ((prem != formula.premise()) || (conc != formula.conclusion())) {
-				newFormula = Formula(IMPLIES, {prem, conc});
-			}
-			break;
-		}
-		case ITE: {
-			Formula<Pol> cond = visit_result(formula.condition(), func);
-			Formula<Pol> fCase = visit_result(formula.first_case(), func);
-			Formula<Pol> sCase = visit_result(formula.second_case(), func);
-			if ((cond != formula.condition()) || (fCase != formula.first_case()) || (sCase != formula.second_case())) {
-				newFormula = Formula(ITE, {cond, fCase, sCase});
-			}
-			break;
-		}
-		case BOOL:
-		case CONSTRAINT:
-		case VARCOMPARE:
-		case VARASSIGN:
-		case BITVECTOR:
-		case TRUE:
-		case FALSE:
-		case UEQ:
-			break;
-		case EXISTS:
-		case FORALL: {
-			Formula<Pol> sub = visit_result(formula.quantified_formula(), func);
-			if (sub != formula.quantified_formula()) {
-				newFormula = Formula<Pol>(formula.type(), formula.quantified_variables(), sub);
+	std::unordered_map<std::size_t, Formula<Pol>> results;
+	return visit_result(formula, func, results);
+}
+
+/**
+ * Calls func on every subformula and return a new formula, like visit_result() above.
+ * The results are memoized in the given table, which maps formula ids to results.
+ * Passing the same table to multiple calls with the same func reuses the results of earlier calls.
+ * @param formula Formula to visit.
+ * @param func Function to call.
+ * @param results Memoized results.
+ * @return New formula.
+ */
+template<typename Pol, typename Visitor>
+Formula<Pol> visit_result(const Formula<Pol>& formula, Visitor func, std::unordered_map<std::size_t, Formula<Pol>>& results) {
+	auto result = [&results](const Formula<Pol>& f) -> const Formula<Pol>& {
+		assert(results.find(f.id()) != results.end());
+		return results.find(f.id())->second;
+	};
+	detail_visit::traverse(formula,
+		[&results](const Formula<Pol>& f) { return results.find(f.id()) == results.end(); },
+		[&results, &result, &func](const Formula<Pol>& formula) {
+			if (results.find(formula.id()) != results.end()) return;
+			Formula<Pol> newFormula = formula;
+			switch (formula.type()) {
+				case AND:
+				case OR:
+				case IFF:
+				case XOR: {
+					Formulas<typename Formula<Pol>::PolynomialType> newSubformulas;
+					bool changed = false;
+					for (const auto& cur: formula.subformulas()) {
+						const Formula<Pol>& newCur = result(cur);
+						if (newCur != cur) changed = true;
+						newSubformulas.push_back(newCur);
+					}
+					if (changed) {
+						newFormula = Formula(formula.type(), std::move(newSubformulas));
+					}
+					break;
+				}
+				case NOT: {
+					const Formula<Pol>& cur = result(formula.subformula());
+					if (cur != formula.subformula()) {
+						newFormula = !cur;
+					}
+					break;
+				}
+				case IMPLIES: {
+					const Formula<Pol>& prem = result(formula.premise());
+					const Formula<Pol>& conc = result(formula.conclusion());
+					if ((prem != formula.premise()) || (conc != formula.conclusion())) {
+						newFormula = Formula(IMPLIES, {prem, conc});
+					}
+					break;
+				}
+				case ITE: {
+					const Formula<Pol>& cond = result(formula.condition());
+					const Formula<Pol>& fCase = result(formula.first_case());
+					const Formula<Pol>& sCase = result(formula.second_case());
+					if ((cond != formula.condition()) || (fCase != formula.first_case()) || (sCase != formula.second_case())) {
+						newFormula = Formula(ITE, {cond, fCase, sCase});
+					}
+					break;
+				}
+				case BOOL:
+				case CONSTRAINT:
+				case VARCOMPARE:
+				case VARASSIGN:
+				case BITVECTOR:
+				case TRUE:
+				case FALSE:
+				case UEQ:
+					break;
+				case EXISTS:
+				case FORALL: {
+					const Formula<Pol>& sub = result(formula.quantified_formula());
+					if (sub != formula.quantified_formula()) {
+						newFormula = Formula<Pol>(formula.type(), formula.quantified_variables(), sub);
+					}
+					break;
+				}
 			}
-			break;
+			results.emplace(formula.id(), func(newFormula));
 		}
-	}
-	return func(newFormula);
+	);
+	return result(formula);
 }
 
 
-}
\ No newline at end of file
+}
@@ -2,6 +2,13 @@
 
 #include <carl-logging/carl-logging.h>
 
+#include <atomic>
+#include <map>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
 #include "ModelVariable.h"
 #include "ModelValue.h"
 
@@ -14,6 +21,16 @@ namespace carl
 	 * for these variables.
 	 * Most notably, a value can be a "carl::ModelSubstitution" whose value depends
 	 * on the values of other variables in the Model.
+	 *
+	 * Copies of a model share their assignments until one of them is modified (copy-on-write), hence copying a model is cheap.
+	 * To try a candidate assignment, snapshot() and rollback() should be used instead: they only record and restore the modified entries.
+	 * Every state of a model has a revision, which is used to cache the values of substitutions per state.
+	 *
+	 * Unlike std::map, the model only hands out const iterators, also from non-const find(), insert() and emplace().
+	 * Otherwise a value could be changed through an iterator without the model noticing, which would neither detach a shared map,
+	 * nor record the change for rollback(), nor invalidate cached values of substitutions.
+	 * Code that used to modify a value through an iterator has to use assign() instead, e.g. `model.assign(key, value)` instead of
+	 * `model.find(key)->second = value` or `model.insert(pair).first->second = value`.
 	 */
 	template<typename Rational, typename Poly>
 	class Model {
@@ -24,118 +41,215 @@ namespace carl
 		static_assert(std::is_same<key_type, typename Map::key_type>::value, "Should be the same type");
 		static_assert(std::is_same<mapped_type, typename Map::mapped_type>::value, "Should be the same type");
 	private:
-		Map mData;
+		/// A modification of the model, storing the previous value of the key if there was one.
+		using TrailEntry = std::pair<key_type, std::optional<mapped_type>>;
+		/// A snapshot consists of the size of the trail and the revision at the time of the snapshot.
+		using Snapshot = std::pair<std::size_t, std::size_t>;
+
+		std::shared_ptr<Map> mData = std::make_shared<Map>();
 		std::map<key_type, std::size_t> mUsedInSubstitution;
-		void resetCaches() const {
-			for (const auto& d: mData) {
-				if (d.second.isSubstitution()) {
-					d.second.asSubstitution()->resetCache();
-				}
+		/// Identifies the current state, see revision().
+		std::size_t mRevision = 0;
+		/// Modifications since the oldest open snapshot.
+		std::vector<TrailEntry> mTrail;
+		std::vector<Snapshot> mSnapshots;
+
+		static std::size_t fresh_revision() {
+			static std::atomic<std::size_t> revisions(1);
+			return revisions++;
+		}
+		/// Makes sure that the assignments are not shared with another model, before they are modified.
+		Map& data() {
+			if (mData.use_count() > 1) {
+				mData = std::make_shared<Map>(*mData);
+			}
+			return *mData;
+		}
+		/// Records that the value of key is about to be modified and returns the assignments.
+		Map& modify(const key_type& key) {
+			Map& map = data();
+			if (!mSnapshots.empty()) {
+				auto it = map.find(key);
+				if (it == map.end()) mTrail.emplace_back(key, std::nullopt);
+				else mTrail.emplace_back(key, it->second);
 			}
+			mRevision = fresh_revision();
+			return map;
+		}
+		/// Records that the given entry is about to be removed and moves its value into the trail.
+		void record_erase(typename Map::iterator it) {
+			if (!mSnapshots.empty()) {
+				mTrail.emplace_back(it->first, std::move(it->second));
+			}
+			mRevision = fresh_revision();
 		}
 	public:
 		// Element access
 		const auto& at(const key_type& key) const {
-			return mData.at(key);
+			return mData->at(key);
 		}
 		
 		// Iterators
-		auto begin() const {
-			return mData.begin();
+		typename Map::const_iterator begin() const {
+			return std::as_const(*mData).begin();
 		}
-		auto end() const {
-			return mData.end();
+		typename Map::const_iterator end() const {
+			return std::as_const(*mData).end();
 		}
 		// Capacity
 		auto empty() const {
-			return mData.empty();
+			return mData->empty();
 		}
 		auto size() const {
-			return mData.size();
+			return mData->size();
 		}
 		// Modifiers
+		// The model never hands out mutable iterators, such that every modification is recorded by the model. Use assign() to change values.
 		void clear() {
-			mData.clear();
+			if (mSnapshots.empty()) {
+				mData = std::make_shared<Map>();
+			} else {
+				Map& map = data();
+				for (auto it = map.begin(); it != map.end(); ++it) {
+					record_erase(it);
+				}
+				map.clear();
+			}
+			mRevision = fresh_revision();
 		}
 		template<typename P>
-		auto insert(const P& pair) {
-			resetCaches();
-			return mData.insert(pair);
+		std::pair<typename Map::const_iterator, bool> insert(const P& pair) {
+			auto it = find(pair.first);
+			if (it != end()) return std::make_pair(it, false);
+			return modify(pair.first).insert(pair);
 		}
 		template<typename P>
-		auto insert(typename Map::const_iterator it, const P& pair) {
-			resetCaches();
-			return mData.insert(it, pair);
+		typename Map::const_iterator insert(typename Map::const_iterator hint, const P& pair) {
+			auto it = find(pair.first);
+			if (it != end()) return it;
+			// The hint may point into a map that is shared with a copy of this model.
+			if (mData.use_count() > 1) return insert(pair).first;
+			return modify(pair.first).insert(hint, pair);
 		}
 		template<typename... Args>
-		auto emplace(const key_type& key, Args&& ...args) {
-			resetCaches();
-			return mData.emplace(key,std::forward<Args>(args)...);
+		std::pair<typename Map::const_iterator, bool> emplace(const key_type& key, Args&& ...args) {
+			auto it = find(key);
+			if (it != end()) return std::make_pair(it, false);
+			return modify(key).emplace(key,std::forward<Args>(args)...);
 		}
 		template<typename... Args>
-		auto emplace_hint(typename Map::const_iterator it, const key_type& key, Args&& ...args) {
-			resetCaches();
-			return mData.emplace_hint(it, key,std::forward<Args>(args)...);
-		}
-		typename Map::iterator erase(const ModelVariable& variable) {
-			resetCaches();
-			return erase(mData.find(variable));
+		typename Map::const_iterator emplace_hint(typename Map::const_iterator hint, const key_type& key, Args&& ...args) {
+			auto it = find(key);
+			if (it != end()) return it;
+			if (mData.use_count() > 1) return emplace(key, std::forward<Args>(args)...).first;
+			return modify(key).emplace_hint(hint, key,std::forward<Args>(args)...);
 		}
-		typename Map::iterator erase(const typename Map::iterator& it) {
-			resetCaches();
-			return erase(typename Map::const_iterator(it));
+		typename Map::const_iterator erase(const ModelVariable& variable) {
+			return erase(find(variable));
 		}
-		typename Map::iterator erase(const typename Map::const_iterator& it) {
-			if (it == mData.end()) return mData.end();
-			return mData.erase(it);
+		typename Map::const_iterator erase(typename Map::const_iterator it) {
+			if (it == end()) return it;
+			// The iterator may point into a map that is shared with a copy of this model, hence it is looked up again after detaching.
+			key_type key = it->first;
+			Map& map = data();
+			auto mit = map.find(key);
+			record_erase(mit);
+			return map.erase(mit);
 		}
         void clean() {
-            for (auto& m: mData) {
+            for (auto& m: data()) {
 				const auto& val = m.second;
 				if (!val.isSubstitution()) continue;
 				const auto& subs = val.asSubstitution();
                 CARL_LOG_DEBUG("carl.formula.model", "Evaluating " << m.first << " ->  " << subs << " as.");
-                m.second = subs->evaluate(*this);
+                auto value = subs->evaluate(*this);
+                modify(m.first);
+                m.second = std::move(value);
 			}
         }
 		// Lookup
-		auto find(const typename Map::key_type& key) const {
-			return mData.find(key);
+		typename Map::const_iterator find(const typename Map::key_type& key) const {
+			return std::as_const(*mData).find(key);
 		}
-		auto find(const typename Map::key_type& key) {
-			return mData.find(key);
+
+		// Snapshots
+		/**
+		 * Takes a snapshot of the current state, which can be restored by rollback().
+		 * Snapshots may be nested. Taking a snapshot is constant time, afterwards the previous value of every modified entry is recorded.
+		 * @return The number of open snapshots.
+		 */
+		std::size_t snapshot() {
+			mSnapshots.emplace_back(mTrail.size(), mRevision);
+			return mSnapshots.size();
+		}
+		/**
+		 * Restores the state of the last snapshot and closes it.
+		 * This only restores the entries that were modified since the snapshot. Cached values of substitutions for this state are valid again.
+		 */
+		void rollback() {
+			assert(!mSnapshots.empty());
+			auto [trailSize, revision] = mSnapshots.back();
+			mSnapshots.pop_back();
+			Map& map = data();
+			while (mTrail.size() > trailSize) {
+				auto& entry = mTrail.back();
+				if (entry.second) {
+					map.insert_or_assign(entry.first, std::move(*entry.second));
+				} else {
+					map.erase(entry.first);
+				}
+				mTrail.pop_back();
+			}
+			mRevision = revision;
+		}
+		/**
+		 * Closes the last snapshot and keeps all modifications.
+		 */
+		void commit() {
+			assert(!mSnapshots.empty());
+			mSnapshots.pop_back();
+			if (mSnapshots.empty()) mTrail.clear();
+		}
+		/// @return The number of open snapshots.
+		std::size_t snapshots() const {
+			return mSnapshots.size();
+		}
+		/**
+		 * @return An identifier of the current state of this model.
+		 * Two models with the same revision have the same assignments, and the revision changes with every modification.
+		 */
+		std::size_t revision() const {
+			return mRevision;
 		}
 		
 		// Additional (w.r.t. std::map)
 		Model() = default;
 		Model(const std::map<Variable, Rational>& assignment) {
 			for (const auto& a: assignment) {
-				mData.emplace(a.first, a.second);
+				mData->emplace(a.first, a.second);
 			}
+			if (!assignment.empty()) mRevision = fresh_revision();
 		}
 		template<typename Container>
 		bool contains(const Container& c) const {
 			for (const auto& var: c) {
-				if (mData.find(var) == mData.end()) return false;
+				if (mData->find(var) == mData->end()) return false;
 			}
 			return true;
 		}
 		template<typename T>
 		void assign(const typename Map::key_type& key, const T& t) {
-			auto it = mData.find(key);
-			if (it == mData.end()) mData.emplace(key, t);
+			Map& map = modify(key);
+			auto it = map.find(key);
+			if (it == map.end()) map.emplace(key, t);
 			else it->second = t;
 		}
 		void update(const Model& model, bool disjoint = true) {
 			for (const auto& m: model) {
-				auto res = mData.insert(m);
 				if (disjoint) {
-					assert(res.second);
-				} else {
-					if (!res.second) {
-						res.first->second = m.second;
-					}
+					assert(mData->find(m.first) == mData->end());
 				}
+				assign(m.first, m.second);
 			}
 		}
 		/**
@@ -150,7 +264,7 @@ namespace carl
 		}
 		void print(std::ostream& os, bool simple = true) const {
 			os << "(model" << std::endl;
-			for (const auto& ass: mData) {
+			for (const auto& ass: *mData) {
 				auto value = ass.second;
 				if (simple) value = evaluated(ass.first);
 
@@ -175,7 +289,7 @@ namespace carl
 		void printOneline(std::ostream& os, bool simple = false) const {
 			os << "{";
 			bool first = true;
-			for (const auto& ass: mData) {
+			for (const auto& ass: *mData) {
 				if (!first) os << ", ";
 				auto value = ass.second;
 				if (simple) value = evaluated(ass.first);
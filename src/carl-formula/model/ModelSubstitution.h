@@ -5,6 +5,7 @@
 #include <memory>
 
 #include <optional>
+#include <utility>
 
 #include <carl-formula/formula/Formula.h>
 #include <carl-arith/extended/MultivariateRoot.h>
@@ -25,7 +26,8 @@ namespace carl {
 	template<typename Rational, typename Poly>
 	class ModelSubstitution {
 	private:
-		mutable std::optional<ModelValue<Rational, Poly>> mCachedValue;
+		/// The value of the last evaluation and the revision of the model it was evaluated on.
+		mutable std::optional<std::pair<ModelValue<Rational, Poly>, std::size_t>> mCachedValue;
 		
 	protected:
 		/// Evaluate this substitution with respect to the given model.
@@ -34,11 +36,15 @@ namespace carl {
 		ModelSubstitution() = default;
 		virtual ~ModelSubstitution() noexcept = default;
 		
+		/**
+		 * Evaluate this substitution with respect to the given model.
+		 * The result is cached as long as the model stays at the same revision.
+		 */
 		const ModelValue<Rational, Poly>& evaluate(const Model<Rational, Poly>& model) const {
-			if (mCachedValue == std::nullopt) {
-				mCachedValue = evaluateSubstitution(model);
+			if (mCachedValue == std::nullopt || mCachedValue->second != model.revision()) {
+				mCachedValue = std::make_pair(evaluateSubstitution(model), model.revision());
 			}
-			return *mCachedValue;
+			return mCachedValue->first;
 		}
 		void resetCache() const {
 			mCachedValue = std::nullopt;
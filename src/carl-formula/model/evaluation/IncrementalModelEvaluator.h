@@ -0,0 +1,277 @@
+#pragma once
+
+#include "ModelEvaluation.h"
+
+#include <carl-formula/formula/Formula.h>
+#include <carl-formula/formula/functions/Visit.h>
+#include <carl-logging/carl-logging.h>
+
+#include <algorithm>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+namespace carl {
+
+/**
+ * Evaluates a set of formulas over a changing model.
+ *
+ * The formulas are stored as a DAG of their distinct subformulas, where every node caches its value and every atom knows the variables it depends on.
+ * When the model changes, only the atoms depending on changed variables are evaluated again,
+ * and only the formulas containing an atom whose value changed are recombined.
+ * Values follow the convention of satisfied_by(): 0 is false, 1 is true and 2 means that the value is not determined by the model.
+ */
+template<typename Rational, typename Poly>
+class IncrementalModelEvaluator {
+	struct Node {
+		Formula<Poly> formula;
+		std::vector<std::size_t> children;
+		std::vector<std::size_t> parents;
+		/// The top-level formulas this node is the root of.
+		std::vector<std::size_t> roots;
+		unsigned value = 2;
+	};
+	/// Nodes in topological order, i.e. children always have smaller indices than their parents.
+	std::vector<Node> mNodes;
+	/// Maps formula ids to nodes.
+	std::unordered_map<std::size_t, std::size_t> mIndex;
+	/// Maps variables to the atoms depending on them.
+	std::map<Variable, std::vector<std::size_t>> mDependencies;
+	/// Atoms that depend on uninterpreted functions.
+	std::vector<std::size_t> mFunctionAtoms;
+	/// The node of every top-level formula.
+	std::vector<std::size_t> mRoots;
+	Model<Rational,Poly> mModel;
+
+	static bool is_operator(FormulaType type) {
+		switch (type) {
+			case FormulaType::NOT:
+			case FormulaType::IMPLIES:
+			case FormulaType::AND:
+			case FormulaType::OR:
+			case FormulaType::XOR:
+			case FormulaType::IFF:
+			case FormulaType::ITE:
+				return true;
+			default:
+				return false;
+		}
+	}
+
+	/// Creates the node of a formula whose subformulas already have nodes.
+	std::size_t create_node(const Formula<Poly>& f) {
+		std::size_t id = mNodes.size();
+		Node node;
+		node.formula = f;
+		if (f.type() == FormulaType::NOT) {
+			node.children.push_back(mIndex.at(f.subformula().id()));
+		} else if (is_operator(f.type())) {
+			for (const auto& sub: f.subformulas()) {
+				node.children.push_back(mIndex.at(sub.id()));
+			}
+		} else {
+			for (auto v: carl::variables(f)) {
+				mDependencies[v].push_back(id);
+			}
+			if (f.type() == FormulaType::UEQ) mFunctionAtoms.push_back(id);
+		}
+		for (std::size_t c: node.children) {
+			mNodes[c].parents.push_back(id);
+		}
+		mNodes.emplace_back(std::move(node));
+		mIndex.emplace(f.id(), id);
+		mNodes[id].value = evaluate_node(mNodes[id]);
+		return id;
+	}
+
+	/// Computes the value of a node from the model or the values of its children.
+	unsigned evaluate_node(const Node& node) const {
+		auto child = [this, &node](std::size_t i) { return mNodes[node.children[i]].value; };
+		switch (node.formula.type()) {
+			case FormulaType::TRUE: return 1;
+			case FormulaType::FALSE: return 0;
+			case FormulaType::NOT: {
+				unsigned v = child(0);
+				return v == 2 ? 2 : 1 - v;
+			}
+			case FormulaType::IMPLIES: {
+				unsigned prem = child(0);
+				unsigned conc = child(1);
+				if (prem == 0 || conc == 1) return 1;
+				if (prem == 1 && conc == 0) return 0;
+				return 2;
+			}
+			case FormulaType::AND: {
+				unsigned res = 1;
+				for (std::size_t i = 0; i < node.children.size(); ++i) {
+					unsigned v = child(i);
+					if (v == 0) return 0;
+					if (v == 2) res = 2;
+				}
+				return res;
+			}
+			case FormulaType::OR: {
+				unsigned res = 0;
+				for (std::size_t i = 0; i < node.children.size(); ++i) {
+					unsigned v = child(i);
+					if (v == 1) return 1;
+					if (v == 2) res = 2;
+				}
+				return res;
+			}
+			case FormulaType::XOR: {
+				unsigned res = 0;
+				for (std::size_t i = 0; i < node.children.size(); ++i) {
+					unsigned v = child(i);
+					if (v == 2) return 2;
+					res ^= v;
+				}
+				return res;
+			}
+			case FormulaType::IFF: {
+				bool equal = true;
+				for (std::size_t i = 0; i < node.children.size(); ++i) {
+					unsigned v = child(i);
+					if (v == 2) return 2;
+					if (v != child(0)) equal = false;
+				}
+				return equal ? 1 : 0;
+			}
+			case FormulaType::ITE: {
+				unsigned cond = child(0);
+				if (cond != 2) return cond == 1 ? child(1) : child(2);
+				return child(1) == child(2) ? child(1) : 2;
+			}
+			default:
+				return satisfied_by(node.formula, mModel);
+		}
+	}
+
+	/// Returns the variables whose values differ between the current model and the given model.
+	std::set<ModelVariable> changed_variables(const Model<Rational,Poly>& model) const {
+		std::set<ModelVariable> res;
+		auto oldIt = mModel.begin();
+		auto newIt = model.begin();
+		while (oldIt != mModel.end() || newIt != model.end()) {
+			if (newIt == model.end() || (oldIt != mModel.end() && oldIt->first < newIt->first)) {
+				res.insert(oldIt->first);
+				++oldIt;
+			} else if (oldIt == mModel.end() || newIt->first < oldIt->first) {
+				res.insert(newIt->first);
+				++newIt;
+			} else {
+				// Substitutions are only compared by identity, hence they may be reported although their value did not change.
+				if (!(oldIt->second == newIt->second)) res.insert(newIt->first);
+				++oldIt;
+				++newIt;
+			}
+		}
+		return res;
+	}
+
+	/**
+	 * Adds all variables bound to substitutions that depend on a changed variable, until no more variables are added.
+	 * The values of these variables may change although their entries in the model stay the same.
+	 */
+	void add_substitution_dependencies(std::set<ModelVariable>& changed) const {
+		bool added = true;
+		while (added) {
+			added = false;
+			for (const auto& [var, value]: mModel) {
+				if (!value.isSubstitution() || changed.find(var) != changed.end()) continue;
+				const auto& subs = value.asSubstitution();
+				if (std::any_of(changed.begin(), changed.end(), [&subs](const ModelVariable& v) { return subs->dependsOn(v); })) {
+					changed.insert(var);
+					added = true;
+				}
+			}
+		}
+	}
+public:
+	explicit IncrementalModelEvaluator(const Model<Rational,Poly>& model = Model<Rational,Poly>()):
+		mModel(model)
+	{}
+
+	/**
+	 * Adds a top-level formula and evaluates it over the current model.
+	 * Subformulas that are shared with formulas added before are not evaluated again.
+	 * @return The index of the formula.
+	 */
+	std::size_t add(const Formula<Poly>& formula) {
+		detail_visit::traverse(formula,
+			[this](const Formula<Poly>& f) {
+				if (mIndex.find(f.id()) != mIndex.end()) return false;
+				if (is_operator(f.type())) return true;
+				// Atoms and quantified formulas are evaluated as a whole.
+				create_node(f);
+				return false;
+			},
+			[this](const Formula<Poly>& f) {
+				if (mIndex.find(f.id()) == mIndex.end()) create_node(f);
+			}
+		);
+		std::size_t node = mIndex.at(formula.id());
+		mRoots.push_back(node);
+		mNodes[node].roots.push_back(mRoots.size() - 1);
+		return mRoots.size() - 1;
+	}
+
+	/**
+	 * Updates the model and evaluates everything that depends on variables whose values changed.
+	 * If the model is at the same revision as the current model, nothing is evaluated.
+	 * @return The indices of the top-level formulas whose value changed, in increasing order.
+	 */
+	std::vector<std::size_t> update(const Model<Rational,Poly>& model) {
+		if (model.revision() == mModel.revision()) return {};
+		auto changed = changed_variables(model);
+		mModel = model;
+		if (changed.empty()) return {};
+		add_substitution_dependencies(changed);
+
+		// Nodes are processed in topological order, hence every node is evaluated at most once.
+		std::set<std::size_t> queue;
+		for (const auto& var: changed) {
+			if (var.isFunction()) {
+				queue.insert(mFunctionAtoms.begin(), mFunctionAtoms.end());
+				continue;
+			}
+			Variable v = var.is_variable() ? var.asVariable() : (var.isBVVariable() ? var.asBVVariable().variable() : var.asUVariable().variable());
+			auto it = mDependencies.find(v);
+			if (it != mDependencies.end()) queue.insert(it->second.begin(), it->second.end());
+		}
+		CARL_LOG_DEBUG("carl.model.evaluation", changed.size() << " variables changed, affecting " << queue.size() << " atoms");
+		std::vector<std::size_t> res;
+		while (!queue.empty()) {
+			Node& node = mNodes[*queue.begin()];
+			queue.erase(queue.begin());
+			unsigned value = evaluate_node(node);
+			if (value == node.value) continue;
+			node.value = value;
+			queue.insert(node.parents.begin(), node.parents.end());
+			res.insert(res.end(), node.roots.begin(), node.roots.end());
+		}
+		std::sort(res.begin(), res.end());
+		return res;
+	}
+
+	/// @return The value of the top-level formula with the given index, following the convention of satisfied_by().
+	unsigned value(std::size_t index) const {
+		assert(index < mRoots.size());
+		return mNodes[mRoots[index]].value;
+	}
+	/// @return The top-level formula with the given index.
+	const Formula<Poly>& formula(std::size_t index) const {
+		assert(index < mRoots.size());
+		return mNodes[mRoots[index]].formula;
+	}
+	/// @return The number of top-level formulas.
+	std::size_t size() const {
+		return mRoots.size();
+	}
+	const Model<Rational,Poly>& model() const {
+		return mModel;
+	}
+};
+
+}
@@ -20,6 +20,7 @@ class DIMACSExporter {
 private:
 	std::map<carl::Variable, std::size_t> mVariables;
 	std::vector<std::vector<long long>> mClauses;
+	std::size_t mThreads;
 	
 	std::size_t id(carl::Variable::Arg v) {
 		auto it = mVariables.find(v);
@@ -65,29 +66,54 @@ private:
 		CARL_LOG_ERROR("carl.dimacs", "Added formula to DIMACSExporter has a clause that is not pure-boolean: " << f);
 		return false;
 	}
+
+	/// Removes the clauses and variables that were added after the exporter held the given numbers of clauses and variables.
+	void rollback(std::size_t clauses, std::size_t variables) {
+		mClauses.resize(clauses);
+		// Variables are numbered consecutively, hence the ones introduced since have the largest ids.
+		for (auto it = mVariables.begin(); it != mVariables.end();) {
+			if (it->second > variables) it = mVariables.erase(it);
+			else ++it;
+		}
+	}
 	
 public:
+	/**
+	 * @param num_threads Number of threads used to convert the top-level conjuncts of added formulas to CNF, see to_cnf_clauses_parallel().
+	 */
+	explicit DIMACSExporter(std::size_t num_threads = 1):
+		mThreads(num_threads)
+	{}
+
+	/**
+	 * Converts the formula to CNF and adds the resulting clauses.
+	 * The clauses are added while the conversion runs, without constructing the CNF as a single formula.
+	 * If the formula is unsatisfiable (i.e. its CNF contains FALSE) or not purely boolean, none of its clauses and variables are kept.
+	 * @return False if the formula is not purely boolean.
+	 */
 	bool operator()(const Formula<Pol>& formula) {
-		Formula<Pol> f = carl::to_cnf(formula);
-		if (f.type() == TRUE) {
+		if (formula.type() == TRUE) {
 			CARL_LOG_INFO("carl.dimacs", "Added TRUE to DIMACSExporter. Skipping...");
 			return true;
 		}
-		if (f.type() == FALSE) {
+		std::size_t clauses = mClauses.size();
+		std::size_t variables = mVariables.size();
+		bool success = true;
+		bool satisfiable = carl::to_cnf_clauses_parallel(formula, [this, &success](const Formula<Pol>& clause) {
+			if (success && !addDisjunction(clause)) {
+				success = false;
+			}
+		}, mThreads);
+		if (!satisfiable) {
 			CARL_LOG_WARN("carl.dimacs", "Added FALSE to DIMACSExporter. Skipping...");
+			rollback(clauses, variables);
 			return true;
 		}
-		if (f.type() == OR || f.type() == BOOL || f.type() == NOT) {
-			return addDisjunction(f);
+		if (!success) {
+			CARL_LOG_ERROR("carl.dimacs", "Added formula to DIMACSExporter that is not convertible to pure-boolean cnf: " << formula);
+			rollback(clauses, variables);
 		}
-		if (f.type() == AND) {
-			for (const auto& sub: f) {
-				if (!addDisjunction(sub)) return false;
-			}
-			return true;
-		}
-		CARL_LOG_ERROR("carl.dimacs", "Added formula to DIMACSExporter that is not convertible to pure-boolean cnf: " << formula);
-		return false;
+		return success;
 	}
 	void clear() {
 		mVariables.clear();
@@ -7,6 +7,7 @@
 #include <string>
 
 #include <carl-formula/formula/Formula.h>
+#include <carl-formula/formula/FormulaBuilder.h>
 #include <carl-logging/carl-logging.h>
 
 namespace carl::io {
@@ -20,11 +21,11 @@ template<typename Pol>
 class DIMACSImporter {
 private:
 	std::ifstream in;
-	std::vector<Formula<Pol>> variables;
+	std::vector<Variable> variables;
 	std::regex headerRegex;
 	
-	Formula<Pol> parseLine(const std::string& line) const {
-		std::vector<Formula<Pol>> vars;
+	typename FormulaBuilder<Pol>::Node parseLine(const std::string& line, FormulaBuilder<Pol>& builder) const {
+		std::vector<typename FormulaBuilder<Pol>::Node> vars;
 		const char* begin = line.c_str();
 		char* end = nullptr;
 		long long id;
@@ -32,16 +33,18 @@ private:
 			id = std::strtoll(begin, &end, 10);
 			begin = end;
 			if (id == 0) break;
-			Formula<Pol> v = variables.at(std::size_t(std::abs(id)-1));
+			auto v = builder.add(variables.at(std::size_t(std::abs(id)-1)));
 			if (id > 0) vars.emplace_back(v);
-			else vars.emplace_back(NOT, v);
+			else vars.emplace_back(builder.negation(v));
 		}
-		return std::move(Formula<Pol>(OR, std::move(vars)));
+		return builder.add(OR, std::move(vars));
 	}
 	
 	Formula<Pol> parseFormula() {
 		std::string line;
-		std::vector<Formula<Pol>> formulas;
+		// The clauses are only staged and created in a single batch at the end.
+		FormulaBuilder<Pol> builder;
+		std::vector<typename FormulaBuilder<Pol>::Node> formulas;
 		while (!in.eof()) {
 			std::getline(in, line);
 			if (line == "") continue;
@@ -59,9 +62,9 @@ private:
 				}
 				continue;
 			}
-			formulas.push_back(parseLine(line));
+			formulas.push_back(parseLine(line, builder));
 		}
-		return Formula<Pol>(AND, std::move(formulas));
+		return builder.build(builder.add(AND, std::move(formulas)));
 	}
 	
 public:
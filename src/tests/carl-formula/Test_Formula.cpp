@@ -1,10 +1,15 @@
 #include <gtest/gtest.h>
 #include <carl-arith/core/VariablePool.h>
 #include <carl-formula/formula/Formula.h>
+#include <carl-formula/formula/FormulaBuilder.h>
+#include <carl-formula/formula/functions/CNF.h>
+#include <carl-formula/formula/functions/Substitution.h>
 #include <carl-io/StringParser.h>
 
 #include "../Common.h"
 
+#include <thread>
+
 using namespace carl;
 
 typedef MultivariatePolynomial<Rational> Pol;
@@ -404,3 +409,271 @@ TEST(Formula, Uniqueness)
 	FormulaT f2 = FormulaT(vc);
 	EXPECT_EQ(f1, f2);
 }
+
+TEST(Formula, SharedTraversal)
+{
+	// f_i = (f_{i-1} & b_i) | (f_{i-1} & !b_i) has exponentially many occurrences of f_0, but only 5*n+1 distinct subformulas.
+	const std::size_t n = 40;
+	std::vector<Variable> vars;
+	FormulaT f(fresh_boolean_variable("b"));
+	for (std::size_t i = 0; i < n; ++i) {
+		vars.push_back(fresh_boolean_variable("b"));
+		FormulaT b(vars.back());
+		f = FormulaT(FormulaType::OR, FormulaT(FormulaType::AND, f, b), FormulaT(FormulaType::AND, f, !b));
+	}
+
+	std::size_t visited = 0;
+	carl::visit_dag(f, [&visited](const FormulaT&) { ++visited; });
+	EXPECT_EQ(5 * n + 1, visited);
+
+	carlVariables collected;
+	variables(f, collected);
+	EXPECT_EQ(n + 1, collected.size());
+
+	std::size_t calls = 0;
+	FormulaT res = carl::visit_result(f, [&calls](const FormulaT& sub) { ++calls; return sub; });
+	EXPECT_EQ(f, res);
+	EXPECT_EQ(5 * n + 1, calls);
+
+	FormulaT substituted = carl::substitute(f, FormulaT(vars.front()), FormulaT(FormulaType::TRUE));
+	EXPECT_NE(f, substituted);
+	carlVariables remaining;
+	variables(substituted, remaining);
+	EXPECT_FALSE(remaining.has(vars.front()));
+}
+
+TEST(Formula, Epoch)
+{
+	Variable x = fresh_boolean_variable("x");
+	Variable y = fresh_boolean_variable("y");
+	FormulaT fx(x);
+	FormulaT fy(y);
+	std::size_t before = FormulaPool<Pol>::getInstance().size();
+	{
+		FormulaEpoch<Pol> epoch;
+		for (int i = 0; i < 10; ++i) {
+			// Temporary formulas stay in the pool and are found again.
+			FormulaT tmp(FormulaType::AND, fx, FormulaT(FormulaType::OR, fx, !fy));
+			EXPECT_EQ(before + 2, FormulaPool<Pol>::getInstance().size());
+		}
+		EXPECT_EQ(before + 2, FormulaPool<Pol>::getInstance().size());
+	}
+	EXPECT_EQ(before, FormulaPool<Pol>::getInstance().size());
+
+	// Without an epoch, unused formulas are erased immediately.
+	{
+		FormulaT tmp(FormulaType::AND, fx, fy);
+		EXPECT_EQ(before + 1, FormulaPool<Pol>::getInstance().size());
+	}
+	EXPECT_EQ(before, FormulaPool<Pol>::getInstance().size());
+
+	// Formulas still in use at the end of the epoch are kept.
+	FormulaT kept;
+	{
+		FormulaEpoch<Pol> epoch;
+		kept = FormulaT(FormulaType::OR, fx, fy);
+		FormulaT tmp(FormulaType::AND, fx, fy);
+	}
+	EXPECT_EQ(before + 1, FormulaPool<Pol>::getInstance().size());
+}
+
+#ifdef THREAD_SAFE
+TEST(Formula, ConcurrentUsages)
+{
+	Variable x = fresh_boolean_variable("x");
+	Variable y = fresh_boolean_variable("y");
+	FormulaT fx(x);
+	FormulaT fy(y);
+	FormulaT shared(FormulaType::AND, fx, fy);
+	std::size_t before = FormulaPool<Pol>::getInstance().size();
+	std::size_t usages = FormulaPool<Pol>::getInstance().usages(shared);
+
+	std::vector<std::thread> threads;
+	for (int t = 0; t < 8; ++t) {
+		threads.emplace_back([&]() {
+			for (int i = 0; i < 2000; ++i) {
+				// Copies of a shared formula and temporary formulas that are created and erased concurrently.
+				FormulaT copy = shared;
+				FormulaT tmp(FormulaType::OR, fx, !fy);
+				FormulaT neg = !tmp;
+				copy = neg;
+			}
+		});
+	}
+	for (auto& t: threads) t.join();
+
+	EXPECT_EQ(before, FormulaPool<Pol>::getInstance().size());
+	EXPECT_EQ(usages, FormulaPool<Pol>::getInstance().usages(shared));
+}
+#endif
+
+TEST(Formula, CNFClauses)
+{
+	FormulaT a(fresh_boolean_variable("a"));
+	FormulaT b(fresh_boolean_variable("b"));
+	FormulaT c(fresh_boolean_variable("c"));
+	FormulaT d(fresh_boolean_variable("d"));
+	FormulaT f(FormulaType::AND, {
+		FormulaT(FormulaType::OR, a, FormulaT(FormulaType::AND, b, c)),
+		FormulaT(FormulaType::IMPLIES, a, d),
+		FormulaT(FormulaType::ITE, {b, c, !d})
+	});
+
+	FormulaT cnf = to_cnf(f);
+	Formulas<Pol> clauses;
+	EXPECT_TRUE(to_cnf_clauses(f, [&clauses](const FormulaT& clause) { clauses.push_back(clause); }));
+	EXPECT_EQ(cnf, FormulaT(FormulaType::AND, clauses));
+
+	std::set<FormulaT> parallel;
+	EXPECT_TRUE(to_cnf_clauses_parallel(f, [&parallel](const FormulaT& clause) { parallel.insert(clause); }, 4));
+	EXPECT_EQ(std::set<FormulaT>(clauses.begin(), clauses.end()), parallel);
+
+	std::size_t count = 0;
+	EXPECT_FALSE(to_cnf_clauses(FormulaT(FormulaType::FALSE), [&count](const FormulaT&) { ++count; }));
+	EXPECT_TRUE(to_cnf_clauses(FormulaT(FormulaType::TRUE), [&count](const FormulaT&) { ++count; }));
+	EXPECT_EQ(0, count);
+}
+
+#ifdef THREAD_SAFE
+TEST(Formula, CNFClausesThreads)
+{
+	// Enough conjuncts that every worker converts several of them and introduces tseitin variables concurrently.
+	std::vector<FormulaT> vars;
+	for (std::size_t i = 0; i < 34; ++i) {
+		vars.emplace_back(fresh_boolean_variable("v" + std::to_string(i)));
+	}
+	Formulas<Pol> conjuncts;
+	for (std::size_t i = 0; i + 2 < vars.size(); ++i) {
+		conjuncts.emplace_back(FormulaType::OR, vars[i], FormulaT(FormulaType::AND, vars[i + 1], !vars[i + 2]));
+	}
+	FormulaT f(FormulaType::AND, conjuncts);
+
+	Formulas<Pol> sequential;
+	EXPECT_TRUE(to_cnf_clauses(f, [&sequential](const FormulaT& clause) { sequential.push_back(clause); }));
+	Formulas<Pol> parallel;
+	std::set<std::thread::id> threads;
+	EXPECT_TRUE(to_cnf_clauses_parallel(f, [&parallel, &threads](const FormulaT& clause) {
+		parallel.push_back(clause);
+		threads.insert(std::this_thread::get_id());
+	}, 4));
+	EXPECT_EQ(sequential.size(), parallel.size());
+	EXPECT_EQ(std::set<FormulaT>(sequential.begin(), sequential.end()), std::set<FormulaT>(parallel.begin(), parallel.end()));
+	EXPECT_EQ(0, threads.count(std::this_thread::get_id()));
+}
+#endif
+
+TEST(Formula, CachedVariables)
+{
+	Variable x = fresh_real_variable("x");
+	Variable y = fresh_real_variable("y");
+	Variable b = fresh_boolean_variable("b");
+	Constr c(Pol(x) * x + Pol(y), Relation::LESS);
+	FormulaT fc(c);
+	FormulaT g(FormulaType::AND, fc, FormulaT(FormulaType::OR, FormulaT(b), !FormulaT(Constr(Pol(y), Relation::GREATER))));
+
+	EXPECT_EQ(Variables({x, y, b}), g.variables());
+	// The variables of the subformulas are cached as well and returned by reference.
+	EXPECT_EQ(Variables({x, y}), fc.variables());
+	EXPECT_EQ(&fc.variables(), &fc.variables());
+
+	EXPECT_EQ(&c.variables(), &c.variables());
+	EXPECT_EQ(2, c.var_info(x).max_degree());
+	EXPECT_FALSE(c.var_info(x).has_coeff());
+	EXPECT_TRUE(c.var_info<true>(x).has_coeff());
+	EXPECT_EQ(Pol(1), c.coefficient(x, 2));
+	EXPECT_EQ(0, c.var_info(b).num_occurences());
+	EXPECT_EQ(2, c.max_degree());
+}
+
+TEST(Formula, NormalizedBound)
+{
+	Variable x = fresh_real_variable("x");
+	Variable y = fresh_real_variable("y");
+	Constr c1(Pol(Rational(-2)) * x + Rational(4), Relation::LESS);
+	const auto& b1 = c1.normalized_bound();
+	EXPECT_EQ(Pol(x), b1.poly);
+	EXPECT_EQ(Rational(2), b1.bound);
+	EXPECT_EQ(Relation::GREATER, b1.relation);
+	EXPECT_EQ(std::hash<Pol>()(Pol(x)), b1.hash);
+	EXPECT_EQ(&b1, &c1.normalized_bound());
+
+	Constr c2(Pol(x) + y - Rational(1), Relation::LEQ);
+	EXPECT_EQ(Pol(x) + y, c2.normalized_bound().poly);
+	EXPECT_EQ(Rational(1), c2.normalized_bound().bound);
+
+	// Bounds on the same polynomial are grouped, regardless of the constraint they stem from.
+	ConstraintBounds<Pol> bounds;
+	addConstraintBound(bounds, FormulaT(c1), true);
+	addConstraintBound(bounds, FormulaT(Constr(Pol(Rational(3)) * x - Rational(9), Relation::LEQ)), true);
+	addConstraintBound(bounds, FormulaT(c2), true);
+	ASSERT_EQ(2, bounds.size());
+	EXPECT_EQ(2, bounds.at(c1).size());
+
+	// x > 2 and x <= 1 is detected as a conflict.
+	FormulaT f(FormulaType::AND, FormulaT(c1), FormulaT(Constr(x, Relation::LEQ, Rational(1))));
+	EXPECT_EQ(FormulaT(FormulaType::FALSE), to_cnf(f, true, true));
+	// x >= 2 and x <= 2 is combined to x = 2.
+	FormulaT g(FormulaType::AND, FormulaT(Constr(x, Relation::GEQ, Rational(2))), FormulaT(Constr(x, Relation::LEQ, Rational(2))));
+	EXPECT_EQ(FormulaT(Constr(x, Relation::EQ, Rational(2))), to_cnf(g, true, true));
+}
+
+TEST(Formula, Builder)
+{
+	Variable a = fresh_boolean_variable("a");
+	Variable b = fresh_boolean_variable("b");
+	Variable x = fresh_real_variable("x");
+	Constr c(x, Relation::LESS, Rational(1));
+
+	FormulaBuilder<Pol> builder;
+	auto na = builder.add(a);
+	auto nb = builder.add(b);
+	EXPECT_EQ(na, builder.add(a));
+	auto left = builder.add(FormulaType::OR, { na, builder.negation(nb) });
+	EXPECT_EQ(left, builder.add(FormulaType::OR, { na, builder.negation(nb) }));
+	auto right = builder.add(FormulaType::IMPLIES, { builder.add(c), nb });
+	auto root = builder.add(FormulaType::AND, { left, right, builder.add(FormulaT(FormulaType::TRUE)) });
+	FormulaT f = builder.build(root);
+
+	FormulaT expected(FormulaType::AND, {
+		FormulaT(FormulaType::OR, FormulaT(a), !FormulaT(b)),
+		FormulaT(FormulaType::IMPLIES, FormulaT(c), FormulaT(b))
+	});
+	EXPECT_EQ(expected, f);
+
+	// Formulas can be staged on top of built ones.
+	auto neg = builder.negation(root);
+	EXPECT_EQ(!expected, builder.build(neg));
+	EXPECT_EQ(expected, builder.build(root));
+}
+
+TEST(Formula, SubstitutionCache)
+{
+	Variable x = fresh_real_variable("x");
+	Variable y = fresh_real_variable("y");
+	FormulaT c1(Pol(x) * y - Rational(1), Relation::LESS);
+	FormulaT c2(Pol(x) + y, Relation::EQ);
+	FormulaT f(FormulaType::AND, c1, FormulaT(FormulaType::OR, !c1, c2));
+	std::map<Variable, Pol> replacements{ { y, Pol(x) } };
+
+	FormulaT expected(FormulaType::AND,
+		FormulaT(Pol(x) * x - Rational(1), Relation::LESS),
+		FormulaT(FormulaType::OR, FormulaT(Pol(x) * x - Rational(1), Relation::GEQ), FormulaT(Pol(x) * Rational(2), Relation::EQ))
+	);
+	EXPECT_EQ(expected, substitute(f, replacements));
+
+	SubstitutionCache<Pol> cache;
+	EXPECT_EQ(expected, substitute(f, replacements, cache));
+	std::size_t cached = cache.size();
+	EXPECT_LT(0, cached);
+	EXPECT_EQ(expected, substitute(f, replacements, cache));
+	EXPECT_EQ(cached, cache.size());
+	// Subformulas are cached as well.
+	EXPECT_EQ(FormulaT(Pol(x) * Rational(2), Relation::EQ), substitute(c2, replacements, cache));
+	EXPECT_EQ(cached, cache.size());
+
+	std::map<Variable, Pol> other{ { y, Pol(Rational(0)) } };
+	EXPECT_EQ(FormulaT(Pol(x), Relation::EQ), substitute(c2, other, cache));
+	EXPECT_LT(cached, cache.size());
+	cache.clear();
+	EXPECT_EQ(0, cache.size());
+}
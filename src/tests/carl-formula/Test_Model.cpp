@@ -43,3 +43,63 @@ TYPED_TEST(Model, ModelSubstitution)
 	EXPECT_TRUE(m.at(x).asRational() == TypeParam(3));
 	EXPECT_TRUE(m.at(y).isSubstitution());
 }
+
+TYPED_TEST(Model, Snapshot)
+{
+	using Poly = carl::MultivariatePolynomial<TypeParam>;
+	using ModelPolySubs = carl::ModelPolynomialSubstitution<TypeParam,Poly>;
+
+	carl::Variable x = carl::fresh_real_variable("x");
+	carl::Variable y = carl::fresh_real_variable("y");
+	carl::Variable z = carl::fresh_real_variable("z");
+	carl::Model<TypeParam,Poly> m;
+	m.emplace(carl::ModelVariable(x), TypeParam(3));
+	m.emplace(carl::ModelVariable(y), carl::createSubstitution<TypeParam,Poly,ModelPolySubs>(Poly(TypeParam(2) * x)));
+	EXPECT_EQ(m.evaluated(y).asRational(), TypeParam(6));
+
+	// Copies share their assignments until they are modified.
+	carl::Model<TypeParam,Poly> copy = m;
+	EXPECT_EQ(copy.revision(), m.revision());
+	copy.assign(x, TypeParam(5));
+	EXPECT_EQ(copy.evaluated(y).asRational(), TypeParam(10));
+	EXPECT_EQ(m.at(x).asRational(), TypeParam(3));
+	EXPECT_EQ(m.evaluated(y).asRational(), TypeParam(6));
+
+	auto revision = m.revision();
+	EXPECT_EQ(m.snapshot(), 1);
+	m.assign(x, TypeParam(4));
+	m.emplace(carl::ModelVariable(z), TypeParam(1));
+	EXPECT_NE(m.revision(), revision);
+	EXPECT_EQ(m.evaluated(y).asRational(), TypeParam(8));
+	EXPECT_EQ(m.snapshot(), 2);
+	m.erase(x);
+	m.erase(z);
+	EXPECT_EQ(m.size(), 1);
+	m.rollback();
+	EXPECT_EQ(m.size(), 3);
+	EXPECT_EQ(m.evaluated(y).asRational(), TypeParam(8));
+	m.rollback();
+	EXPECT_EQ(m.snapshots(), 0);
+	EXPECT_EQ(m.revision(), revision);
+	EXPECT_EQ(m.size(), 2);
+	EXPECT_EQ(m.at(x).asRational(), TypeParam(3));
+	EXPECT_EQ(m.evaluated(y).asRational(), TypeParam(6));
+
+	m.snapshot();
+	m.assign(x, TypeParam(1));
+	m.commit();
+	EXPECT_EQ(m.snapshots(), 0);
+	EXPECT_EQ(m.evaluated(y).asRational(), TypeParam(2));
+
+	// Lookups are not modifications.
+	revision = m.revision();
+	EXPECT_NE(m.find(x), m.end());
+	EXPECT_EQ(m.revision(), revision);
+
+	// An iterator taken before copying only erases the entry from this model.
+	auto it = m.find(x);
+	carl::Model<TypeParam,Poly> copy2 = m;
+	m.erase(it);
+	EXPECT_EQ(m.find(x), m.end());
+	EXPECT_EQ(copy2.at(x).asRational(), TypeParam(1));
+}
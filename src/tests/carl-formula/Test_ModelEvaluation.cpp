@@ -4,6 +4,7 @@
 #include <carl-arith/constraint/Substitution.h>
 #include <carl-formula/model/Model.h>
 #include <carl-formula/model/evaluation/ModelEvaluation.h>
+#include <carl-formula/model/evaluation/IncrementalModelEvaluator.h>
 
 #include "../Common.h"
 
@@ -109,3 +110,75 @@ TEST(ModelEvaluation, EvaluateBV)
 	auto res = carl::evaluate(f, m);
 	std::cout << res << std::endl;
 }
+
+TEST(ModelEvaluation, Incremental)
+{
+	Variable x = fresh_real_variable("x");
+	Variable y = fresh_real_variable("y");
+	Variable b = fresh_boolean_variable("b");
+	FormulaT cx(ConstraintT(Pol(x) - Rational(1), carl::Relation::GREATER));
+	FormulaT cy(ConstraintT(Pol(y), carl::Relation::LESS));
+	FormulaT fb(b);
+	FormulaT f1(FormulaType::AND, {cx, FormulaT(FormulaType::OR, {cy, fb})});
+	FormulaT f2(FormulaType::IMPLIES, {fb, cy});
+	FormulaT f3(FormulaType::NOT, cx);
+
+	ModelT m;
+	m.assign(x, Rational(2));
+	IncrementalModelEvaluator<Rational,Pol> eval(m);
+	EXPECT_EQ(eval.add(f1), 0);
+	EXPECT_EQ(eval.add(f2), 1);
+	EXPECT_EQ(eval.add(f3), 2);
+	EXPECT_EQ(eval.value(0), 2);
+	EXPECT_EQ(eval.value(1), 2);
+	EXPECT_EQ(eval.value(2), 0);
+
+	m.assign(b, true);
+	EXPECT_EQ(eval.update(m), std::vector<std::size_t>({0}));
+	EXPECT_EQ(eval.value(0), 1);
+	EXPECT_EQ(eval.value(1), 2);
+	EXPECT_TRUE(eval.update(m).empty());
+
+	m.assign(y, Rational(1));
+	EXPECT_EQ(eval.update(m), std::vector<std::size_t>({1}));
+	EXPECT_EQ(eval.value(1), 0);
+
+	m.snapshot();
+	m.assign(x, Rational(0));
+	EXPECT_EQ(eval.update(m), std::vector<std::size_t>({0, 2}));
+	EXPECT_EQ(eval.value(0), 0);
+	EXPECT_EQ(eval.value(2), 1);
+	m.rollback();
+	EXPECT_EQ(eval.update(m), std::vector<std::size_t>({0, 2}));
+	for (std::size_t i = 0; i < eval.size(); ++i) {
+		EXPECT_EQ(eval.value(i), satisfied_by(eval.formula(i), m));
+	}
+}
+
+TEST(ModelEvaluation, IncrementalSubstitution)
+{
+	Variable x = fresh_real_variable("x");
+	Variable y = fresh_real_variable("y");
+	Variable z = fresh_real_variable("z");
+	FormulaT cy(ConstraintT(Pol(y) - Rational(3), carl::Relation::GREATER));
+	FormulaT cz(ConstraintT(Pol(z), carl::Relation::LESS));
+
+	// y = 2 * x and z = y - 5 only change through x.
+	ModelT m;
+	m.assign(x, Rational(1));
+	m.emplace(y, carl::createSubstitution<Rational,Pol,carl::ModelPolynomialSubstitution<Rational, Pol>>(Pol(Rational(2)) * x));
+	m.emplace(z, carl::createSubstitution<Rational,Pol,carl::ModelPolynomialSubstitution<Rational, Pol>>(Pol(y) - Rational(5)));
+	IncrementalModelEvaluator<Rational,Pol> eval(m);
+	eval.add(cy);
+	eval.add(cz);
+	EXPECT_EQ(eval.value(0), 0);
+	EXPECT_EQ(eval.value(1), 1);
+
+	m.assign(x, Rational(3));
+	EXPECT_EQ(eval.update(m), std::vector<std::size_t>({0, 1}));
+	EXPECT_EQ(eval.value(0), 1);
+	EXPECT_EQ(eval.value(1), 0);
+	for (std::size_t i = 0; i < eval.size(); ++i) {
+		EXPECT_EQ(eval.value(i), satisfied_by(eval.formula(i), m));
+	}
+}
@@ -0,0 +1,87 @@
+#include "gtest/gtest.h"
+
+#include "../Common.h"
+
+#include <carl-io/DIMACSExporter.h>
+
+#include <sstream>
+
+using namespace carl;
+using Poly = carl::MultivariatePolynomial<mpq_class>;
+using FormulaT = Formula<Poly>;
+
+namespace {
+template<typename Exporter>
+std::string to_string(const Exporter& exporter) {
+	std::stringstream ss;
+	ss << exporter;
+	return ss.str();
+}
+}
+
+TEST(DIMACSExporter, Streaming)
+{
+	FormulaT a(fresh_boolean_variable("a"));
+	FormulaT b(fresh_boolean_variable("b"));
+	FormulaT c(fresh_boolean_variable("c"));
+	io::DIMACSExporter<Poly> exporter;
+	EXPECT_TRUE(exporter(FormulaT(FormulaType::OR, a, !b)));
+	EXPECT_TRUE(exporter(!c));
+	EXPECT_TRUE(exporter(FormulaT(FormulaType::TRUE)));
+	EXPECT_EQ("p cnf 3 2\n1 -2 0\n-3 0\n", to_string(exporter));
+
+	// The clauses of a conjunction are appended in an unspecified order.
+	EXPECT_TRUE(exporter(FormulaT(FormulaType::AND, FormulaT(FormulaType::OR, b, c), FormulaT(FormulaType::OR, !a, c))));
+	std::string out = to_string(exporter);
+	EXPECT_EQ("p cnf 3 4\n1 -2 0\n-3 0\n", out.substr(0, 22));
+	EXPECT_NE(std::string::npos, out.find("\n2 3 0\n"));
+	EXPECT_NE(std::string::npos, out.find("\n-1 3 0\n"));
+
+	exporter.clear();
+	EXPECT_EQ("p cnf 0 0\n", to_string(exporter));
+}
+
+TEST(DIMACSExporter, Rollback)
+{
+	FormulaT a(fresh_boolean_variable("a"));
+	FormulaT b(fresh_boolean_variable("b"));
+	FormulaT c(fresh_boolean_variable("c"));
+	FormulaT d(fresh_boolean_variable("d"));
+	FormulaT e(fresh_boolean_variable("e"));
+	Variable x = fresh_real_variable("x");
+	io::DIMACSExporter<Poly> exporter;
+	EXPECT_TRUE(exporter(FormulaT(FormulaType::OR, a, b)));
+	std::string before = to_string(exporter);
+
+	// The boolean clause is emitted before the constraint, both have to be dropped.
+	FormulaT clause(FormulaType::OR, c, d);
+	FormulaT constraint(Constraint<Poly>(Poly(x), Relation::LESS));
+	EXPECT_FALSE(exporter(FormulaT(FormulaType::AND, clause, constraint)));
+	EXPECT_EQ(before, to_string(exporter));
+
+	// Only the variables of the dropped formula are removed, new variables continue the numbering.
+	EXPECT_TRUE(exporter(!e));
+	EXPECT_EQ("p cnf 3 2\n1 2 0\n-3 0\n", to_string(exporter));
+}
+
+TEST(DIMACSExporter, Threads)
+{
+	std::vector<FormulaT> vars;
+	for (std::size_t i = 0; i < 8; ++i) {
+		vars.emplace_back(fresh_boolean_variable("t" + std::to_string(i)));
+	}
+	Formulas<Poly> conjuncts;
+	for (std::size_t i = 0; i + 1 < vars.size(); ++i) {
+		conjuncts.emplace_back(FormulaType::OR, vars[i], !vars[i + 1]);
+	}
+	FormulaT f(FormulaType::AND, conjuncts);
+	io::DIMACSExporter<Poly> sequential;
+	io::DIMACSExporter<Poly> parallel(4);
+	EXPECT_TRUE(sequential(f));
+	EXPECT_TRUE(parallel(f));
+	// The order of the clauses and hence the numbering of the variables may differ, the header may not.
+	std::string s = to_string(sequential);
+	std::string p = to_string(parallel);
+	EXPECT_EQ(s.substr(0, s.find('\n')), p.substr(0, p.find('\n')));
+	EXPECT_EQ(std::count(s.begin(), s.end(), '-'), std::count(p.begin(), p.end(), '-'));
+}
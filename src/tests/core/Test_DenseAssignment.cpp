@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include <carl-arith/core/DenseAssignment.h>
+#include <carl-arith/core/VariablePool.h>
+#include <carl-arith/intervalcontraction/Contraction.h>
+#include <carl-arith/poly/umvpoly/MultivariatePolynomial.h>
+#include <carl-arith/poly/umvpoly/functions/Evaluation.h>
+#include <carl-arith/poly/umvpoly/functions/IntervalEvaluation.h>
+#include <carl-arith/poly/umvpoly/functions/Substitution.h>
+
+#include "../Common.h"
+
+using namespace carl;
+
+TEST(DenseAssignment, Basic)
+{
+	Variable x = fresh_real_variable("x");
+	Variable y = fresh_real_variable("y");
+	Variable i = fresh_integer_variable("i");
+	DenseAssignment<int> a;
+	EXPECT_TRUE(a.empty());
+	EXPECT_TRUE(a.emplace(x, 1).second);
+	EXPECT_FALSE(a.emplace(x, 2).second);
+	a[i] = 3;
+	EXPECT_EQ(a.size(), 2);
+	EXPECT_EQ(a.at(x), 1);
+	EXPECT_EQ(a.at(i), 3);
+	EXPECT_EQ(a.count(y), 0);
+	EXPECT_TRUE(a.find(y) == a.end());
+	EXPECT_THROW(a.at(y), std::out_of_range);
+	a.insert_or_assign(x, 4);
+	EXPECT_EQ(a.find(x)->second, 4);
+
+	std::map<Variable, int> m;
+	for (const auto& e: a) m.emplace(e.first, e.second);
+	EXPECT_EQ(m, a.to_map());
+	EXPECT_EQ(DenseAssignment<int>(m), a);
+
+	EXPECT_EQ(a.erase(x), 1);
+	EXPECT_EQ(a.erase(x), 0);
+	EXPECT_EQ(a.size(), 1);
+	EXPECT_EQ(a.begin()->first, i);
+	a.clear();
+	EXPECT_TRUE(a.empty());
+	EXPECT_TRUE(a.begin() == a.end());
+}
+
+TEST(DenseAssignment, Evaluation)
+{
+	Variable x = fresh_real_variable("x");
+	Variable y = fresh_real_variable("y");
+	MultivariatePolynomial<Rational> p({Rational(3)*x*x*y, Rational(-2)*y, Term<Rational>(Rational(1, 2))});
+
+	std::map<Variable, Rational> m = {{x, Rational(1, 3)}, {y, Rational(-5)}};
+	DenseAssignment<Rational> d(m);
+	EXPECT_EQ(carl::evaluate(p, d), carl::evaluate(p, m));
+
+	std::map<Variable, Rational> partial = {{y, Rational(2)}};
+	EXPECT_EQ(carl::substitute(p, DenseAssignment<Rational>(partial)), carl::substitute(p, partial));
+
+	Interval<double>::evalintervalmap im = {{x, Interval<double>(-1.0, 2.0)}, {y, Interval<double>(0.5, 3.0)}};
+	DenseAssignment<Interval<double>> di(im);
+	EXPECT_EQ(carl::evaluate(p, di), carl::evaluate(p, im));
+}
+
+TEST(DenseAssignment, Contraction)
+{
+	Variable a = fresh_real_variable("a");
+	Variable b = fresh_real_variable("b");
+	MultivariatePolynomial<Rational> p({Rational(12)*a, Rational(3)*b*b, Term<Rational>(Rational(-4))});
+	Contraction<SimpleNewton, MultivariatePolynomial<Rational>> contractor(p);
+
+	Interval<double>::evalintervalmap map = {{a, Interval<double>(-3.0, 4.0)}, {b, Interval<double>(-1.0, 2.0)}};
+	DenseAssignment<Interval<double>> dense(map);
+	for (Variable v: {a, b}) {
+		Interval<double> resA, resB, denseA, denseB;
+		bool split = contractor(map, v, resA, resB);
+		bool denseSplit = contractor(dense, v, denseA, denseB);
+		EXPECT_EQ(split, denseSplit);
+		EXPECT_EQ(resA, denseA);
+		if (split) {
+			EXPECT_EQ(resB, denseB);
+		}
+	}
+}
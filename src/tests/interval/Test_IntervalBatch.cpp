@@ -0,0 +1,174 @@
+#include "gtest/gtest.h"
+#include <carl-arith/interval/IntervalBatch.h>
+#include <carl-arith/core/VariablePool.h>
+#include <carl-arith/poly/umvpoly/functions/IntervalEvaluation.h>
+#include <carl-arith/poly/umvpoly/functions/IntervalBatchEvaluation.h>
+
+#include "../Common.h"
+
+#include <random>
+
+using namespace carl;
+
+namespace {
+
+std::vector<Interval<double>> sample_intervals() {
+	std::vector<Interval<double>> res = {
+		Interval<double>(0.1, 0.3),
+		Interval<double>(-0.7, 0.2),
+		Interval<double>(-3.0, -1.0 / 3.0),
+		Interval<double>(0.0, 0.0),
+		Interval<double>(1e300, 1e308),
+		Interval<double>(2.0, BoundType::WEAK, 0.0, BoundType::INFTY),
+		Interval<double>(0.0, BoundType::INFTY, -1.0, BoundType::WEAK),
+		Interval<double>::unbounded_interval(),
+	};
+	std::mt19937 gen(42);
+	std::uniform_real_distribution<double> dist(-10.0, 10.0);
+	for (int i = 0; i < 40; ++i) {
+		double a = dist(gen);
+		double b = dist(gen);
+		res.emplace_back(std::min(a, b), std::max(a, b));
+	}
+	return res;
+}
+
+/// Checks that the batch result encloses the exact result on the rational intervals.
+void expect_encloses(const Interval<double>& res, const Interval<Rational>& exact) {
+	if (exact.lower_bound_type() != BoundType::INFTY) {
+		EXPECT_TRUE(res.lower_bound_type() == BoundType::INFTY || Rational(res.lower()) <= exact.lower()) << res << " does not enclose " << exact;
+	} else {
+		EXPECT_EQ(res.lower_bound_type(), BoundType::INFTY) << res << " does not enclose " << exact;
+	}
+	if (exact.upper_bound_type() != BoundType::INFTY) {
+		EXPECT_TRUE(res.upper_bound_type() == BoundType::INFTY || exact.upper() <= Rational(res.upper())) << res << " does not enclose " << exact;
+	} else {
+		EXPECT_EQ(res.upper_bound_type(), BoundType::INFTY) << res << " does not enclose " << exact;
+	}
+}
+
+Interval<Rational> to_rational(const Interval<double>& i) {
+	return Interval<Rational>(
+		i.lower_bound_type() == BoundType::INFTY ? Rational(0) : Rational(i.lower()), i.lower_bound_type(),
+		i.upper_bound_type() == BoundType::INFTY ? Rational(0) : Rational(i.upper()), i.upper_bound_type()
+	);
+}
+
+}
+
+TEST(IntervalBatch, Conversion)
+{
+	auto intervals = sample_intervals();
+	IntervalBatch<double> batch(intervals);
+	ASSERT_EQ(batch.size(), intervals.size());
+	for (std::size_t i = 0; i < intervals.size(); ++i) {
+		EXPECT_EQ(batch[i], intervals[i]);
+	}
+	IntervalBatch<double> constant(5, Interval<double>(2.0, 3.0));
+	EXPECT_EQ(constant.size(), 5);
+	EXPECT_EQ(constant[4], Interval<double>(2.0, 3.0));
+}
+
+TEST(IntervalBatch, Arithmetic)
+{
+	auto intervals = sample_intervals();
+	std::vector<Interval<double>> lhs;
+	std::vector<Interval<double>> rhs;
+	for (const auto& a: intervals) {
+		for (const auto& b: intervals) {
+			lhs.push_back(a);
+			rhs.push_back(b);
+		}
+	}
+	IntervalBatch<double> a(lhs);
+	IntervalBatch<double> b(rhs);
+	auto sum = a + b;
+	auto difference = a - b;
+	auto product = a * b;
+	auto quotient = a / b;
+	for (std::size_t i = 0; i < lhs.size(); ++i) {
+		bool finite = !lhs[i].is_unbounded() && !rhs[i].is_unbounded();
+		if (finite) {
+			auto ra = to_rational(lhs[i]);
+			auto rb = to_rational(rhs[i]);
+			expect_encloses(sum[i], ra + rb);
+			expect_encloses(difference[i], ra - rb);
+			expect_encloses(product[i], ra * rb);
+			if (!rb.contains(0)) {
+				expect_encloses(quotient[i], ra.div(rb));
+			}
+		}
+		if (rhs[i].contains(0.0)) {
+			EXPECT_TRUE(quotient[i].is_infinite());
+		}
+	}
+	// Products with zero are zero, even for unbounded intervals.
+	EXPECT_EQ((IntervalBatch<double>(1, Interval<double>(0.0)) * IntervalBatch<double>(1, Interval<double>::unbounded_interval()))[0], Interval<double>(0.0));
+	// Outward rounding.
+	auto third = IntervalBatch<double>(1, Interval<double>(1.0)) / IntervalBatch<double>(1, Interval<double>(3.0));
+	EXPECT_LT(third[0].lower(), third[0].upper());
+	// Aliasing the result with an argument.
+	add(a, b, a);
+	EXPECT_EQ(a[0], sum[0]);
+}
+
+TEST(IntervalBatch, Power)
+{
+	auto intervals = sample_intervals();
+	IntervalBatch<double> batch(intervals);
+	for (unsigned e = 1; e < 6; ++e) {
+		IntervalBatch<double> res;
+		pow(batch, e, res);
+		for (std::size_t i = 0; i < intervals.size(); ++i) {
+			if (intervals[i].is_unbounded()) continue;
+			expect_encloses(res[i], carl::pow(to_rational(intervals[i]), e));
+		}
+	}
+	IntervalBatch<double> res;
+	pow(batch, 0, res);
+	EXPECT_EQ(res[0], Interval<double>(1.0));
+	sqr(IntervalBatch<double>(1, Interval<double>(-2.0, 1.0)), res);
+	EXPECT_EQ(res[0], Interval<double>(0.0, 4.0));
+	pow(IntervalBatch<double>(1, Interval<double>(-2.0, 1.0)), 3, res);
+	EXPECT_EQ(res[0], Interval<double>(-8.0, 1.0));
+	sqr(IntervalBatch<double>(1, Interval<double>(2.0, BoundType::WEAK, 0.0, BoundType::INFTY)), res);
+	EXPECT_EQ(res[0], Interval<double>(4.0, BoundType::WEAK, 0.0, BoundType::INFTY));
+}
+
+TEST(IntervalBatch, Evaluation)
+{
+	Variable x = fresh_real_variable("x");
+	Variable y = fresh_real_variable("y");
+	MultivariatePolynomial<Rational> p({Rational(1, 3)*x*x*y, Rational(-2)*x*y, Rational(1)*y*y*y, Term<Rational>(Rational(7, 5))});
+
+	auto intervals = sample_intervals();
+	std::vector<Interval<double>> xs;
+	std::vector<Interval<double>> ys;
+	for (std::size_t i = 0; i + 1 < intervals.size(); ++i) {
+		xs.push_back(intervals[i]);
+		ys.push_back(intervals[i + 1]);
+	}
+	std::map<Variable, IntervalBatch<double>> map;
+	map.emplace(x, IntervalBatch<double>(xs));
+	map.emplace(y, IntervalBatch<double>(ys));
+	auto res = carl::evaluate(p, map);
+	ASSERT_EQ(res.size(), xs.size());
+	for (std::size_t i = 0; i < xs.size(); ++i) {
+		if (xs[i].is_unbounded() || ys[i].is_unbounded()) continue;
+		std::map<Variable, Interval<Rational>> exact_map = {{x, to_rational(xs[i])}, {y, to_rational(ys[i])}};
+		expect_encloses(res[i], carl::evaluate(p, exact_map));
+	}
+}
+
+TEST(IntervalBatch, ConstantEvaluation)
+{
+	// Without variables, the size of the batch has to be given explicitly.
+	MultivariatePolynomial<Rational> p(Rational(3));
+	std::map<Variable, IntervalBatch<double>> map;
+	auto res = carl::evaluate(p, map, 3);
+	ASSERT_EQ(res.size(), 3);
+	for (std::size_t i = 0; i < res.size(); ++i) {
+		EXPECT_EQ(res[i], Interval<double>(3.0));
+	}
+	EXPECT_EQ(carl::evaluate(Term<Rational>(Rational(2)), map, 2).size(), 2);
+}
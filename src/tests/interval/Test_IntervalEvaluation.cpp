@@ -2,6 +2,9 @@
 #include <carl-arith/interval/Interval.h>
 #include <carl-arith/core/VariablePool.h>
 #include <carl-arith/poly/umvpoly/functions/IntervalEvaluation.h>
+#include <carl-arith/poly/umvpoly/functions/AdaptiveEvaluation.h>
+#include <carl-arith/poly/umvpoly/functions/AffineEvaluation.h>
+#include <carl-arith/poly/umvpoly/functions/SignFilter.h>
 #include <carl-common/meta/platform.h>
 
 #include "../Common.h"
@@ -85,3 +88,119 @@ TEST(IntervalEvaluation, Term)
 TEST(IntervalEvaluation, MultivariatePolynomial)
 {
 }
+
+TEST(IntervalEvaluation, FilteredSign)
+{
+	std::map<Variable, Interval<Rational>> map;
+	Variable a = fresh_real_variable("a");
+	Variable b = fresh_real_variable("b");
+	Variable c = fresh_real_variable("c");
+	map[a] = Interval<Rational>(Rational(1, 3), BoundType::STRICT, Rational(1, 2), BoundType::STRICT);
+	map[b] = Interval<Rational>(Rational(-7, 5));
+	map[c] = Interval<Rational>(Rational(3, 4));
+
+	MultivariatePolynomial<Rational> pa(a);
+	MultivariatePolynomial<Rational> pb(b);
+	MultivariatePolynomial<Rational> pc(c);
+	// Decided: the signs are definite on the box.
+	EXPECT_EQ(std::optional<Sign>(Sign::POSITIVE), carl::filtered_sgn(pa * pa - pb, map));
+	EXPECT_EQ(std::optional<Sign>(Sign::NEGATIVE), carl::filtered_sgn(pa * pb, map));
+	// Decided: 3/4 is a double, hence 4*c - 3 evaluates to exactly zero.
+	EXPECT_EQ(std::optional<Sign>(Sign::ZERO), carl::filtered_sgn(Rational(4) * pc - Rational(3), map));
+	EXPECT_EQ(std::optional<Sign>(Sign::ZERO), carl::filtered_sgn(pc * pc - Rational(9, 16), map));
+	// Decided: 5*b + 7 + 2^-30 is positive, the rounding error of -7/5 is far smaller.
+	Rational delta = Rational(1) / Rational(mpz_class(1) << 30);
+	EXPECT_EQ(std::optional<Sign>(Sign::POSITIVE), carl::filtered_sgn(Rational(5) * pb + Rational(7) + delta, map));
+	EXPECT_EQ(std::optional<Sign>(Sign::NEGATIVE), carl::filtered_sgn(Rational(5) * pb + Rational(7) - delta, map));
+
+	// Refused: a - 2/5 changes its sign on the box.
+	EXPECT_EQ(std::nullopt, carl::filtered_sgn(pa - Rational(2, 5), map));
+	EXPECT_EQ(std::nullopt, carl::filtered_sgn(pa * pc - Rational(1, 3), map));
+	// Refused: 5*b + 7 is zero, but -7/5 is not representable as a double (nor as a binary MPFR number).
+	EXPECT_EQ(std::nullopt, carl::filtered_sgn(Rational(5) * pb + Rational(7), map));
+	EXPECT_EQ(std::nullopt, carl::filtered_sgn(pb * pb - Rational(49, 25), map));
+}
+
+TEST(IntervalEvaluation, Affine)
+{
+	std::map<Variable, Interval<Rational>> map;
+	Variable a = fresh_real_variable("a");
+	Variable b = fresh_real_variable("b");
+	map[a] = Interval<Rational>(Rational(9, 10), Rational(11, 10));
+	map[b] = Interval<Rational>(Rational(19, 20), Rational(21, 20));
+
+	MultivariatePolynomial<Rational> pa(a);
+	MultivariatePolynomial<Rational> pb(b);
+	// (a - b)^2 ranges over [0, 9/400] on the box
+	MultivariatePolynomial<Rational> p = pa * pa - Rational(2) * pa * pb + pb * pb;
+	Interval<Rational> plain = carl::evaluate(p, map);
+	Interval<Rational> affine = carl::evaluate_affine<Rational>(p, map);
+	EXPECT_TRUE(set_is_subset(Interval<Rational>(Rational(0), Rational(9, 400)), affine));
+	EXPECT_LT(affine.diameter() * 10, plain.diameter());
+	EXPECT_EQ(set_intersection(plain, affine), carl::evaluate(p, map, IntervalEvaluationMode::AFFINE));
+
+	std::map<Variable, Interval<double>> dmap;
+	dmap[a] = Interval<double>(0.9, 1.1);
+	dmap[b] = Interval<double>(0.95, 1.05);
+	Interval<double> daffine = carl::evaluate(p, dmap, IntervalEvaluationMode::AFFINE);
+	EXPECT_LE(daffine.lower(), 0);
+	EXPECT_GE(daffine.upper(), 0.0225);
+	EXPECT_LT(daffine.diameter() * 10, carl::evaluate(p, dmap).diameter());
+
+	// Unbounded domains are kept in the remainder.
+	map[b] = Interval<Rational>(Rational(0), BoundType::WEAK, Rational(0), BoundType::INFTY);
+	affine = carl::evaluate_affine<Rational>(p, map);
+	EXPECT_TRUE(affine.is_unbounded());
+}
+
+#ifdef USE_MPFR_FLOAT
+TEST(IntervalEvaluation, AdaptiveMpfr)
+{
+	std::map<Variable, Interval<mpq_class>> map;
+	Variable a = fresh_real_variable("a");
+	mpq_class eps = mpq_class(1) / (mpq_class(mpz_class(1) << 100));
+	map[a] = Interval<mpq_class>(mpq_class(1, 3) + eps, mpq_class(1, 3) + 2 * eps);
+
+	// 3*a - 1 is positive, but less than 2^-98.
+	MultivariatePolynomial<mpq_class> p = mpq_class(3) * MultivariatePolynomial<mpq_class>(a) - mpq_class(1);
+	AdaptiveMpfrEvaluator evaluator(p);
+	EXPECT_EQ(Sign::POSITIVE, *evaluator.sgn(map));
+	EXPECT_GT(evaluator.precision(), 53);
+	EXPECT_LE(evaluator.precision(), 212);
+
+	// 1/3 is not representable, hence the sign of 3*a - 1 on a = 1/3 is never determined.
+	map[a] = Interval<mpq_class>(mpq_class(1, 3));
+	EXPECT_FALSE(evaluator.sgn(map));
+	EXPECT_EQ(evaluator.precision(), 848);
+
+	AdaptiveMpfrEvaluator coarse(p, 53, 64);
+	map[a] = Interval<mpq_class>(mpq_class(1, 3) + eps, mpq_class(1, 3) + 2 * eps);
+	EXPECT_FALSE(coarse.sgn(map));
+	EXPECT_EQ(coarse.iterations(), 1);
+}
+
+TEST(IntervalEvaluation, FilteredSignMpfr)
+{
+	std::map<Variable, Interval<mpq_class>> map;
+	Variable a = fresh_real_variable("a");
+	mpq_class eps = mpq_class(1) / (mpq_class(mpz_class(1) << 100));
+	map[a] = Interval<mpq_class>(mpq_class(1, 3) + eps, mpq_class(1, 3) + 2 * eps);
+	MultivariatePolynomial<mpq_class> p = mpq_class(3) * MultivariatePolynomial<mpq_class>(a) - mpq_class(1);
+
+	// The double stage can not decide the sign, the evaluator is created once and reused afterwards.
+	EXPECT_EQ(Sign::POSITIVE, *carl::filtered_sgn(p, map));
+	AdaptiveMpfrEvaluator& cached = carl::detail_sign_filter::mpfr_evaluator(p);
+	EXPECT_EQ(cached.precision(), 106);
+	EXPECT_EQ(Sign::POSITIVE, *carl::filtered_sgn(p, map));
+	EXPECT_EQ(&cached, &carl::detail_sign_filter::mpfr_evaluator(p));
+	EXPECT_NE(&cached, &carl::detail_sign_filter::mpfr_evaluator(p + mpq_class(1)));
+
+	AdaptiveMpfrEvaluator evaluator(p, 106);
+	EXPECT_EQ(Sign::POSITIVE, *carl::filtered_sgn(p, map, evaluator));
+	EXPECT_EQ(evaluator.iterations(), 1);
+	map[a] = Interval<mpq_class>(mpq_class(1, 2));
+	EXPECT_EQ(Sign::POSITIVE, *carl::filtered_sgn(p, map, evaluator));
+	// Decided by the double stage.
+	EXPECT_EQ(evaluator.iterations(), 1);
+}
+#endif
@@ -0,0 +1,200 @@
+#include "gtest/gtest.h"
+#include <carl-arith/interval/Interval.h>
+#include <carl-arith/interval/inplace.h>
+#include <carl-arith/core/VariablePool.h>
+#include <carl-arith/poly/umvpoly/functions/IntervalEvaluation.h>
+
+#include "../Common.h"
+
+using namespace carl;
+
+namespace {
+
+using MpqInterval = Interval<mpq_class>;
+
+std::vector<MpqInterval> sample_intervals() {
+	std::vector<MpqInterval> res;
+	std::vector<mpq_class> numbers = { mpq_class(-7, 3), mpq_class(-1), mpq_class(0), mpq_class(1, 2), mpq_class(5, 4) };
+	std::vector<BoundType> types = { BoundType::WEAK, BoundType::STRICT };
+	for (const auto& l: numbers) {
+		for (const auto& u: numbers) {
+			if (u < l) continue;
+			for (auto lt: types) {
+				for (auto ut: types) {
+					res.emplace_back(l, lt, u, ut);
+				}
+			}
+		}
+	}
+	res.emplace_back(mpq_class(1), BoundType::WEAK, mpq_class(0), BoundType::INFTY);
+	res.emplace_back(mpq_class(0), BoundType::INFTY, mpq_class(-1, 3), BoundType::STRICT);
+	res.emplace_back(MpqInterval::unbounded_interval());
+	res.emplace_back(MpqInterval::empty_interval());
+	return res;
+}
+
+}
+
+TEST(IntervalInplace, Binary)
+{
+	auto intervals = sample_intervals();
+	MpqInterval res;
+	for (const auto& a: intervals) {
+		for (const auto& b: intervals) {
+			add(a, b, res);
+			EXPECT_EQ(a + b, res) << a << " + " << b;
+			sub(a, b, res);
+			EXPECT_EQ(a - b, res) << a << " - " << b;
+			mul(a, b, res);
+			EXPECT_EQ(a * b, res) << a << " * " << b;
+		}
+	}
+}
+
+TEST(IntervalInplace, Unary)
+{
+	auto intervals = sample_intervals();
+	MpqInterval res;
+	for (const auto& a: intervals) {
+		neg(a, res);
+		EXPECT_EQ(-a, res) << a;
+		for (unsigned exp = 1; exp < 5; ++exp) {
+			pow(a, exp, res);
+			EXPECT_EQ(carl::pow(a, exp), res) << a << "^" << exp;
+		}
+		for (const auto& n: { mpq_class(-3, 2), mpq_class(0), mpq_class(2) }) {
+			add(a, n, res);
+			EXPECT_EQ(a + n, res) << a << " + " << n;
+			mul(a, n, res);
+			EXPECT_EQ(a * n, res) << a << " * " << n;
+		}
+	}
+}
+
+TEST(IntervalInplace, Division)
+{
+	auto intervals = sample_intervals();
+	MpqInterval res;
+	MpqInterval res2;
+	for (const auto& a: intervals) {
+		for (const auto& n: { mpq_class(-3, 2), mpq_class(2) }) {
+			div(a, n, res);
+			EXPECT_EQ(a / n, res) << a << " / " << n;
+		}
+		for (const auto& b: intervals) {
+			if (b.is_empty()) continue;
+			if (!b.contains(mpq_class(0))) {
+				div(a, b, res);
+				EXPECT_EQ(a.div(b), res) << a << " / " << b;
+			}
+			MpqInterval expected1;
+			MpqInterval expected2;
+			bool split = a.div_ext(b, expected1, expected2);
+			EXPECT_EQ(split, div_ext(a, b, res, res2)) << a << " / " << b;
+			EXPECT_EQ(expected1, res) << a << " / " << b;
+			if (split) {
+				EXPECT_EQ(expected2, res2) << a << " / " << b;
+			}
+		}
+	}
+}
+
+TEST(IntervalInplace, AbsSqrt)
+{
+	MpqInterval res;
+	for (const auto& a: sample_intervals()) {
+		abs(a, res);
+		EXPECT_EQ(a.abs(), res) << a;
+	}
+	Interval<double> dres;
+	for (const auto& a: { Interval<double>(-1.0, BoundType::WEAK, 4.0, BoundType::STRICT), Interval<double>(2.0, BoundType::STRICT, 9.0, BoundType::WEAK), Interval<double>(-3.0, BoundType::WEAK, -2.0, BoundType::WEAK) }) {
+		sqrt(a, dres);
+		EXPECT_EQ(carl::sqrt(a), dres) << a;
+		sqrt_assign(dres = a);
+		EXPECT_EQ(carl::sqrt(a), dres) << a;
+	}
+}
+
+TEST(IntervalInplace, Assign)
+{
+	auto intervals = sample_intervals();
+	MpqInterval res;
+	for (const auto& a: intervals) {
+		for (const auto& b: intervals) {
+			res = a;
+			add_assign(res, b);
+			EXPECT_EQ(a + b, res) << a << " += " << b;
+			res = a;
+			sub_assign(res, b);
+			EXPECT_EQ(a - b, res) << a << " -= " << b;
+			res = a;
+			mul_assign(res, b);
+			EXPECT_EQ(a * b, res) << a << " *= " << b;
+			if (!b.is_empty() && !b.contains(mpq_class(0))) {
+				res = a;
+				div_assign(res, b);
+				EXPECT_EQ(a.div(b), res) << a << " /= " << b;
+			}
+		}
+		mpq_class n(-3, 2);
+		res = a;
+		add_assign(res, n);
+		EXPECT_EQ(a + n, res) << a << " += " << n;
+		res = a;
+		mul_assign(res, n);
+		EXPECT_EQ(a * n, res) << a << " *= " << n;
+		res = a;
+		div_assign(res, n);
+		EXPECT_EQ(a / n, res) << a << " /= " << n;
+		res = a;
+		neg_assign(res);
+		EXPECT_EQ(-a, res) << a;
+		res = a;
+		abs_assign(res);
+		EXPECT_EQ(a.abs(), res) << a;
+		res = a;
+		pow_assign(res, 3u);
+		EXPECT_EQ(carl::pow(a, 3u), res) << a;
+	}
+}
+
+TEST(IntervalInplace, Aliasing)
+{
+	MpqInterval a(mpq_class(-1), BoundType::STRICT, mpq_class(2), BoundType::WEAK);
+	MpqInterval b(mpq_class(1, 2), BoundType::WEAK, mpq_class(3), BoundType::WEAK);
+	MpqInterval res = a;
+	mul(res, b, res);
+	EXPECT_EQ(a * b, res);
+	res = b;
+	sub(a, res, res);
+	EXPECT_EQ(a - b, res);
+	res = a;
+	mul(res, res, res);
+	EXPECT_EQ(a * a, res);
+	res = a;
+	pow(res, 2u, res);
+	EXPECT_EQ(carl::pow(a, 2u), res);
+	assign(mpq_class(3, 7), res);
+	EXPECT_EQ(MpqInterval(mpq_class(3, 7)), res);
+}
+
+TEST(IntervalInplace, Evaluation)
+{
+	Variable x = fresh_real_variable("x");
+	Variable y = fresh_real_variable("y");
+	MultivariatePolynomial<mpq_class> p({mpq_class(3, 2) * x * x * y, mpq_class(-1) * x * y, mpq_class(2) * y, Term<mpq_class>(mpq_class(-5))});
+	std::map<Variable, MpqInterval> map;
+	map[x] = MpqInterval(mpq_class(-1), BoundType::STRICT, mpq_class(2), BoundType::WEAK);
+	map[y] = MpqInterval(mpq_class(1, 3), BoundType::WEAK, mpq_class(1), BoundType::STRICT);
+	MpqInterval expected(0);
+	for (const auto& t: p) {
+		MpqInterval term(t.coeff());
+		if (t.monomial()) {
+			for (const auto& [var, exp]: *t.monomial()) {
+				term = term * carl::pow(map.at(var), exp);
+			}
+		}
+		expected = expected + term;
+	}
+	EXPECT_EQ(expected, carl::evaluate(p, map));
+}
@@ -0,0 +1,112 @@
+#include "gtest/gtest.h"
+#include <carl-arith/interval/Interval.h>
+#include <carl-arith/interval/IntervalSet.h>
+#include <carl-arith/constraint/BasicConstraint.h>
+#include <carl-arith/constraint/IntervalEvaluation.h>
+#include <carl-arith/core/VariablePool.h>
+#include <carl-arith/poly/umvpoly/MultivariatePolynomial.h>
+
+#include "../Common.h"
+
+using namespace carl;
+
+namespace {
+
+using DInterval = Interval<double>;
+using DSet = IntervalSet<double>;
+
+DInterval closed(double l, double u) {
+	return DInterval(l, BoundType::WEAK, u, BoundType::WEAK);
+}
+DInterval open(double l, double u) {
+	return DInterval(l, BoundType::STRICT, u, BoundType::STRICT);
+}
+
+}
+
+TEST(IntervalSet, Normalization)
+{
+	DSet s{ closed(4, 5), closed(0, 1), DInterval::empty_interval(), closed(2, 3) };
+	EXPECT_EQ(3, s.size());
+	EXPECT_EQ(closed(0, 1), s[0]);
+	EXPECT_EQ(closed(2, 3), s[1]);
+	EXPECT_EQ(closed(4, 5), s[2]);
+
+	s.insert(closed(0.5, 2.5));
+	EXPECT_EQ(2, s.size());
+	EXPECT_EQ(closed(0, 3), s[0]);
+
+	// Connected intervals are merged, open gaps at a single point are kept.
+	DSet t{ DInterval(0, BoundType::WEAK, 1, BoundType::STRICT), DInterval(1, BoundType::WEAK, 2, BoundType::STRICT), open(2, 3) };
+	EXPECT_EQ(2, t.size());
+	EXPECT_EQ(DInterval(0, BoundType::WEAK, 2, BoundType::STRICT), t[0]);
+	EXPECT_EQ(open(2, 3), t[1]);
+	EXPECT_TRUE(t.contains(1));
+	EXPECT_FALSE(t.contains(2));
+	EXPECT_FALSE(t.contains(3));
+	EXPECT_EQ(DInterval(0, BoundType::WEAK, 3, BoundType::STRICT), t.convex_hull());
+}
+
+TEST(IntervalSet, Operations)
+{
+	DSet a{ closed(0, 2), closed(4, 6) };
+	DSet b{ closed(1, 5), closed(8, 9) };
+
+	EXPECT_EQ(DSet({ closed(0, 6), closed(8, 9) }), set_union(a, b));
+	EXPECT_EQ(DSet({ closed(1, 2), closed(4, 5) }), set_intersection(a, b));
+	EXPECT_EQ(DSet({ DInterval(0, BoundType::WEAK, 1, BoundType::STRICT), DInterval(5, BoundType::STRICT, 6, BoundType::WEAK) }), set_difference(a, b));
+	EXPECT_EQ(DSet({ closed(1, 2) }), set_intersection(a, closed(1, 3)));
+	EXPECT_TRUE(set_intersection(a, DSet()).empty());
+
+	DSet complement = set_complement(a);
+	EXPECT_EQ(3, complement.size());
+	EXPECT_EQ(DInterval(0, BoundType::INFTY, 0, BoundType::STRICT), complement[0]);
+	EXPECT_EQ(open(2, 4), complement[1]);
+	EXPECT_EQ(DInterval(6, BoundType::STRICT, 0, BoundType::INFTY), complement[2]);
+	EXPECT_EQ(DSet::unbounded(), set_union(a, complement));
+	EXPECT_TRUE(set_intersection(a, complement).empty());
+	EXPECT_EQ(a, set_complement(complement));
+	EXPECT_EQ(DSet::unbounded(), set_complement(DSet()));
+
+	EXPECT_TRUE(set_is_subset(closed(4.5, 5), a));
+	EXPECT_FALSE(set_is_subset(closed(1, 5), a));
+}
+
+TEST(IntervalSet, SplitAtLargestGap)
+{
+	DInterval resA, resB;
+	DSet s{ closed(0, 1), closed(2, 3), closed(10, 11), closed(12, 13) };
+	EXPECT_TRUE(s.split_at_largest_gap(resA, resB));
+	EXPECT_EQ(closed(0, 3), resA);
+	EXPECT_EQ(closed(10, 13), resB);
+
+	EXPECT_FALSE(DSet(closed(0, 1)).split_at_largest_gap(resA, resB));
+	EXPECT_EQ(closed(0, 1), resA);
+	EXPECT_TRUE(resB.is_empty());
+}
+
+TEST(IntervalSet, ConsistentWith)
+{
+	Variable x = fresh_real_variable("x");
+	MultivariatePolynomial<mpq_class> p(x);
+	Assignment<DInterval> map;
+	Relation stricter;
+
+	map[x] = closed(0, 1);
+	EXPECT_EQ(2, consistent_with(BasicConstraint(p, Relation::LEQ), map, stricter));
+	EXPECT_EQ(Relation::EQ, stricter);
+	EXPECT_EQ(2, consistent_with(BasicConstraint(p, Relation::NEQ), map, stricter));
+	EXPECT_EQ(Relation::GREATER, stricter);
+	EXPECT_EQ(1, consistent_with(BasicConstraint(p, Relation::GEQ), map, stricter));
+	EXPECT_EQ(0, consistent_with(BasicConstraint(p, Relation::LESS), map, stricter));
+
+	map[x] = closed(-1, 1);
+	EXPECT_EQ(2, consistent_with(BasicConstraint(p, Relation::NEQ), map, stricter));
+	EXPECT_EQ(Relation::NEQ, stricter);
+	EXPECT_EQ(2, consistent_with(BasicConstraint(p, Relation::EQ), map, stricter));
+	EXPECT_EQ(Relation::EQ, stricter);
+
+	map[x] = closed(0, 0);
+	EXPECT_EQ(0, consistent_with(BasicConstraint(p, Relation::NEQ), map));
+	EXPECT_EQ(1, consistent_with(BasicConstraint(p, Relation::EQ), map));
+}
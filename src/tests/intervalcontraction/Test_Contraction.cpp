@@ -92,6 +92,32 @@ TEST(Contraction, SimpleNewton)
     EXPECT_EQ(resultA.is_empty(), true);
 }
 
+TEST(Contraction, AffineEvaluation)
+{
+    Variable x = fresh_real_variable("x");
+    Variable y = fresh_real_variable("y");
+    Interval<double>::evalintervalmap map;
+    map[x] = Interval<double>(0.9, 1.1);
+    map[y] = Interval<double>(0.9, 1.1);
+
+    // (x - y)^2 + x - 1 = 0, the derivative by x depends on x and y but is positive on the box
+    MultivariatePolynomial<Rational> px(x);
+    MultivariatePolynomial<Rational> py(y);
+    MultivariatePolynomial<Rational> e = px * px - Rational(2) * px * py + py * py + px - Rational(1);
+    PolynomialContraction<SimpleNewton> intervalContractor(e);
+    PolynomialContraction<SimpleNewton> affineContractor(e);
+    affineContractor.set_evaluation_mode(IntervalEvaluationMode::AFFINE);
+    EXPECT_EQ(IntervalEvaluationMode::AFFINE, affineContractor.evaluation_mode());
+
+    Interval<double> intervalA, intervalB, affineA, affineB;
+    EXPECT_FALSE(intervalContractor(map, x, intervalA, intervalB));
+    EXPECT_FALSE(affineContractor(map, x, affineA, affineB));
+    // x = 1, y = 1 is a solution
+    EXPECT_TRUE(affineA.contains(1));
+    EXPECT_TRUE(set_is_subset(affineA, intervalA));
+    EXPECT_LT(affineA.diameter(), intervalA.diameter());
+}
+
 #ifndef THREAD_SAFE
 #ifdef USE_CLN_NUMBERS
 typedef cln::cl_RA RationalB;
@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include <carl-arith/core/VariablePool.h>
+#include <carl-arith/intervalcontraction/HC4.h>
+#include <carl-arith/intervalcontraction/Propagation.h>
+#include <carl-arith/poly/umvpoly/functions/horner/MultivariateHorner.h>
+
+#include "../number_types.h"
+
+using namespace carl;
+
+using Poly = MultivariatePolynomial<Rational>;
+
+TEST(HC4, Contract)
+{
+	Variable x = fresh_real_variable("x");
+	Variable y = fresh_real_variable("y");
+	// x^2 + y^2 <= 1
+	HC4Contractor<Rational> hc4(Poly({Rational(1)*x*x, Rational(1)*y*y, Term<Rational>(Rational(-1))}));
+	EXPECT_EQ(hc4.variables().size(), 2);
+
+	DenseAssignment<Interval<double>> box;
+	box.emplace(x, 0.5, 3.0);
+	box.emplace(y, 0.5, 3.0);
+	EXPECT_TRUE(hc4(box, Interval<double>(0, BoundType::INFTY, 0, BoundType::WEAK)));
+	// Both variables are contracted in a single pass.
+	EXPECT_TRUE(box.at(x).contains(std::sqrt(0.75) - 1e-12));
+	EXPECT_LT(box.at(x).upper(), 0.867);
+	EXPECT_LT(box.at(y).upper(), 0.867);
+	EXPECT_EQ(box.at(x).lower(), 0.5);
+
+	// x^2 + y^2 = 4 has no solution within the box.
+	Interval<double>::evalintervalmap map = {{x, Interval<double>(0.5, 0.8)}, {y, Interval<double>(0.5, 0.8)}};
+	EXPECT_FALSE(hc4(map, Interval<double>(3.0)));
+}
+
+TEST(HC4, Horner)
+{
+	Variable x = fresh_real_variable("x");
+	Variable y = fresh_real_variable("y");
+	// x^2 + x*y = 2
+	Poly p({Rational(1)*x*x, Rational(1)*x*y, Term<Rational>(Rational(-2))});
+	HC4Contractor<Rational> plain(p);
+	HC4Contractor<Rational> horner{MultivariateHorner<Poly, strategy>(p)};
+
+	DenseAssignment<Interval<double>> box;
+	box.emplace(x, 1.0, 4.0);
+	box.emplace(y, 0.0, 1.0);
+	auto box2 = box;
+	EXPECT_TRUE(plain(box));
+	EXPECT_TRUE(horner(box2));
+	for (auto v: {x, y}) {
+		// The solution x = 1, y = 1 is retained.
+		EXPECT_TRUE(box.at(v).contains(1.0));
+		EXPECT_TRUE(box2.at(v).contains(1.0));
+	}
+	EXPECT_LT(box.at(x).upper(), 4.0);
+	EXPECT_LT(box2.at(x).upper(), 4.0);
+}
+
+TEST(HC4, Integer)
+{
+	Variable i = fresh_integer_variable("i");
+	HC4Contractor<Rational> hc4(Poly({Rational(2)*i, Term<Rational>(Rational(-3))}));
+	DenseAssignment<Interval<double>> box;
+	box.emplace(i, -10.0, 10.0);
+	EXPECT_FALSE(hc4(box));
+}
+
+TEST(HC4, Propagation)
+{
+	Variable x = fresh_real_variable("x");
+	Variable y = fresh_real_variable("y");
+	PropagationSettings settings;
+	settings.use_hc4 = true;
+	settings.threshold = 0.001;
+	Propagation<Poly> propagation(settings);
+	// x * y = 1, x + y = 5/2
+	propagation.add_constraint(Poly({Rational(1)*x*y, Term<Rational>(Rational(-1))}));
+	propagation.add_constraint(Poly({Rational(1)*x, Rational(1)*y, Term<Rational>(Rational(-5, 2))}));
+
+	Propagation<Poly>::Box box;
+	box.emplace(x, 1.0, 10.0);
+	box.emplace(y, 0.1, 10.0);
+	EXPECT_TRUE(propagation.propagate(box));
+	EXPECT_TRUE(box.at(x).contains(2.0));
+	EXPECT_TRUE(box.at(y).contains(0.5));
+	EXPECT_LT(box.at(x).diameter(), 0.1);
+	EXPECT_LT(box.at(y).diameter(), 0.1);
+}
@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+#include <carl-arith/core/VariablePool.h>
+#include <carl-arith/intervalcontraction/Propagation.h>
+
+#include "../number_types.h"
+
+using namespace carl;
+
+using Poly = MultivariatePolynomial<Rational>;
+
+TEST(Propagation, Equation)
+{
+	Variable x = fresh_real_variable("x");
+	Variable y = fresh_real_variable("y");
+	Propagation<Poly> propagation;
+	// x * y = 1, x = 4 * y
+	propagation.add_constraint(Poly({Rational(1)*x*y, Term<Rational>(Rational(-1))}));
+	propagation.add_constraint(Poly({Rational(1)*x, Rational(-4)*y}));
+	EXPECT_EQ(propagation.size(), 2);
+
+	Propagation<Poly>::Box box;
+	box.emplace(x, 0.1, 10.0);
+	box.emplace(y, 0.1, 10.0);
+	EXPECT_TRUE(propagation.propagate(box));
+	// The solution x = 2, y = 1/2 is retained.
+	EXPECT_TRUE(box.at(x).contains(2.0));
+	EXPECT_TRUE(box.at(y).contains(0.5));
+	// Newton contraction on x * y = 1 does not help, but the linear constraint does.
+	// The bounds are rounded outwards, hence they contain [0.4, 10] and [0.1, 2.5] and are only close to them.
+	EXPECT_TRUE(set_is_subset(Interval<double>(0.4, 10.0), box.at(x)));
+	EXPECT_TRUE(set_is_subset(Interval<double>(0.1, 2.5), box.at(y)));
+	EXPECT_NEAR(box.at(x).lower(), 0.4, 1e-9);
+	EXPECT_NEAR(box.at(x).upper(), 10.0, 1e-9);
+	EXPECT_NEAR(box.at(y).lower(), 0.1, 1e-9);
+	EXPECT_NEAR(box.at(y).upper(), 2.5, 1e-9);
+	EXPECT_EQ(box.size(), 2);
+}
+
+TEST(Propagation, Inequality)
+{
+	Variable x = fresh_real_variable("x");
+	Variable y = fresh_real_variable("y");
+	Propagation<Poly> propagation;
+	// x^2 + y^2 <= 1
+	propagation.add_constraint(BasicConstraint<Poly>(Poly({Rational(1)*x*x, Rational(1)*y*y, Term<Rational>(Rational(-1))}), Relation::LEQ));
+	EXPECT_FALSE(propagation.add_constraint(BasicConstraint<Poly>(Poly(x), Relation::NEQ)));
+
+	Interval<double>::evalintervalmap box = {{x, Interval<double>(0.5, 3.0)}, {y, Interval<double>(0.5, 3.0)}};
+	EXPECT_TRUE(propagation.propagate(box));
+	EXPECT_EQ(box.size(), 2);
+	EXPECT_LT(box.at(x).upper(), 1.5);
+	EXPECT_GE(box.at(x).upper(), 0.866);
+	EXPECT_GE(box.at(y).upper(), 0.866);
+
+	// A smaller threshold continues propagating towards the fixpoint sqrt(3)/2.
+	auto previous = box.at(x);
+	propagation.settings().threshold = 0.0001;
+	EXPECT_TRUE(propagation.propagate(box));
+	EXPECT_LT(box.at(x).upper(), previous.upper());
+	EXPECT_LT(box.at(x).upper(), 0.9);
+	EXPECT_GE(box.at(x).upper(), 0.866);
+}
+
+TEST(Propagation, Conflict)
+{
+	Variable x = fresh_real_variable("x");
+	Variable y = fresh_real_variable("y");
+	Propagation<Poly> propagation;
+	propagation.add_constraint(Poly({Rational(1)*x, Rational(1)*y, Term<Rational>(Rational(-10))}));
+
+	Propagation<Poly>::Box box;
+	box.emplace(x, 0.0, 2.0);
+	box.emplace(y, 0.0, 3.0);
+	EXPECT_FALSE(propagation.propagate(box));
+}
@@ -2,6 +2,9 @@
 
 
 #include <carl-arith/ran/ran.h>
+#include <carl-arith/ran/Conversion.h>
+
+#include <algorithm>
 
 using Poly = carl::UnivariatePolynomial<mpq_class>;
 
@@ -12,7 +15,7 @@ public:
 };
 
 BENCHMARK_F(RAN_Fixture, RAN_Create)(benchmark::State& state) {
-	auto rans = carl::real_roots(p);
+	auto rans = carl::real_roots(p).roots();
 	auto p = rans[0].polynomial();
 	auto i = rans[0].interval();
 	for (auto _ : state) {
@@ -20,22 +23,69 @@ BENCHMARK_F(RAN_Fixture, RAN_Create)(benchmark::State& state) {
 	}
 }
 
-BENCHMARK_F(RAN_Fixture, RAN_CreateRefineOld)(benchmark::State& state) {
-	auto rans = carl::real_roots(p);
+BENCHMARK_F(RAN_Fixture, RAN_CreateRefine)(benchmark::State& state) {
+	auto rans = carl::real_roots(p).roots();
 	auto p = rans[0].polynomial();
 	auto i = rans[0].interval();
 	for (auto _ : state) {
 		auto ran = carl::IntRepRealAlgebraicNumber<mpq_class>(p, i);
-		ran.refine(false);
+		ran.refine();
 	}
 }
 
-BENCHMARK_F(RAN_Fixture, RAN_CreateRefineNew)(benchmark::State& state) {
-	auto rans = carl::real_roots(p);
-	auto p = rans[0].polynomial();
-	auto i = rans[0].interval();
+class RAN_SortFixture: public benchmark::Fixture {
+public:
+	carl::Variable x = carl::fresh_real_variable("x");
+	// Roots of (x^2-2)*(x^2-3)*(x^3-x-1)*(2x-3), every root occurs three times.
+	std::vector<carl::IntRepRealAlgebraicNumber<mpq_class>> rans;
+
+	void SetUp(const ::benchmark::State&) override {
+		rans.clear();
+		for (const auto& p: { Poly(x, {-2, 0, 1}) * Poly(x, {-3, 0, 1}), Poly(x, {-1, -1, 0, 1}), Poly(x, {-3, 2}) }) {
+			auto roots = carl::real_roots(p).roots();
+			for (int i = 0; i < 3; ++i) {
+				rans.insert(rans.end(), roots.begin(), roots.end());
+			}
+		}
+	}
+};
+
+BENCHMARK_F(RAN_SortFixture, RAN_SortPairwise)(benchmark::State& state) {
 	for (auto _ : state) {
-		auto ran = carl::IntRepRealAlgebraicNumber<mpq_class>(p, i);
-		ran.refine(true);
+		auto v = rans;
+		std::sort(v.begin(), v.end());
+		v.erase(std::unique(v.begin(), v.end()), v.end());
+		benchmark::DoNotOptimize(v);
+	}
+}
+
+BENCHMARK_F(RAN_SortFixture, RAN_SortAndDedup)(benchmark::State& state) {
+	for (auto _ : state) {
+		auto v = rans;
+		carl::sort_and_dedup(v);
+		benchmark::DoNotOptimize(v);
+	}
+}
+
+#ifdef USE_LIBPOLY
+BENCHMARK_F(RAN_SortFixture, LPRAN_SortPairwise)(benchmark::State& state) {
+	std::vector<carl::LPRealAlgebraicNumber> lprans;
+	for (const auto& r: rans) lprans.push_back(carl::convert<carl::LPRealAlgebraicNumber>(r));
+	for (auto _ : state) {
+		auto v = lprans;
+		std::sort(v.begin(), v.end());
+		v.erase(std::unique(v.begin(), v.end()), v.end());
+		benchmark::DoNotOptimize(v);
+	}
+}
+
+BENCHMARK_F(RAN_SortFixture, LPRAN_SortAndDedup)(benchmark::State& state) {
+	std::vector<carl::LPRealAlgebraicNumber> lprans;
+	for (const auto& r: rans) lprans.push_back(carl::convert<carl::LPRealAlgebraicNumber>(r));
+	for (auto _ : state) {
+		auto v = lprans;
+		carl::sort_and_dedup(v);
+		benchmark::DoNotOptimize(v);
 	}
 }
+#endif
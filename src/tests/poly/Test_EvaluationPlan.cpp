@@ -0,0 +1,94 @@
+#include "gtest/gtest.h"
+
+#include <carl-arith/poly/umvpoly/MultivariatePolynomial.h>
+#include <carl-arith/poly/umvpoly/functions/Evaluation.h>
+#include <carl-arith/poly/umvpoly/functions/EvaluationPlan.h>
+#include <carl-arith/poly/umvpoly/functions/IntervalEvaluation.h>
+#include <carl-arith/poly/umvpoly/functions/horner/MultivariateHorner.h>
+
+#include "../Common.h"
+
+using namespace carl;
+
+class EvaluationPlanTest: public ::testing::Test {
+protected:
+	using Poly = MultivariatePolynomial<Rational>;
+	Variable x = fresh_real_variable("x");
+	Variable y = fresh_real_variable("y");
+	Variable z = fresh_real_variable("z");
+	// 3/2*x^2*y - x^2*z + y^3 + 2*x - 7
+	Poly p = Poly({Rational(3, 2)*x*x*y, Rational(-1)*x*x*z, Rational(1)*y*y*y, Rational(2)*x, Term<Rational>(Rational(-7))});
+};
+
+TEST_F(EvaluationPlanTest, Structure)
+{
+	EvaluationPlan<Rational> plan(p);
+	EXPECT_EQ(plan.variables(), std::vector<Variable>({x, y, z}));
+	EXPECT_EQ(plan.slot(y), 1);
+	// x^2 is computed only once
+	auto pows = std::count_if(plan.instructions().begin(), plan.instructions().end(), [](const auto& i) {
+		return i.op == EvaluationPlan<Rational>::Op::POW;
+	});
+	EXPECT_EQ(pows, 2);
+
+	EvaluationPlan<Rational> zero(Poly(0));
+	EXPECT_TRUE(zero.variables().empty());
+	EXPECT_EQ(zero.evaluate(std::vector<Rational>()), Rational(0));
+	EvaluationPlan<Rational> constant(Poly(Rational(5)));
+	EXPECT_EQ(constant.evaluate(std::vector<Rational>()), Rational(5));
+}
+
+TEST_F(EvaluationPlanTest, Rational)
+{
+	EvaluationPlan<Rational> plan(p);
+	std::map<Variable, Rational> m = {{x, Rational(1, 3)}, {y, Rational(-2)}, {z, Rational(5, 7)}};
+	EXPECT_EQ(plan.evaluate(m), carl::evaluate(p, m));
+
+	PlanEvaluator<Rational, Rational> evaluator(plan);
+	for (int i = -3; i <= 3; ++i) {
+		std::vector<Rational> values = {Rational(i), Rational(i, 2), Rational(1) / Rational(i == 0 ? 1 : i)};
+		std::map<Variable, Rational> m = {{x, values[0]}, {y, values[1]}, {z, values[2]}};
+		EXPECT_EQ(evaluator(values), carl::evaluate(p, m));
+	}
+}
+
+TEST_F(EvaluationPlanTest, Double)
+{
+	EvaluationPlan<Rational> plan(p);
+	std::vector<double> values = {0.5, -2.0, 4.0};
+	EXPECT_DOUBLE_EQ(plan.evaluate(values), 1.5*0.25*-2.0 - 0.25*4.0 - 8.0 + 1.0 - 7.0);
+}
+
+TEST_F(EvaluationPlanTest, Interval)
+{
+	EvaluationPlan<Rational> plan(p);
+	std::map<Variable, Interval<Rational>> m = {
+		{x, Interval<Rational>(-1, 2)},
+		{y, Interval<Rational>(Rational(1, 2), 3)},
+		{z, Interval<Rational>(0, 1)},
+	};
+	EXPECT_EQ(plan.evaluate(m), carl::evaluate(p, m));
+
+	std::map<Variable, Interval<double>> md = {
+		{x, Interval<double>(-1.0, 2.0)},
+		{y, Interval<double>(0.5, 3.0)},
+		{z, Interval<double>(0.0, 1.0)},
+	};
+	PlanEvaluator<Interval<double>, Rational> evaluator(plan);
+	EXPECT_EQ(evaluator(md), carl::evaluate(p, md));
+}
+
+TEST_F(EvaluationPlanTest, Horner)
+{
+	MultivariateHorner<Poly, strategy> h(p);
+	EvaluationPlan<Rational> plan(h);
+	std::map<Variable, Rational> m = {{x, Rational(1, 3)}, {y, Rational(-2)}, {z, Rational(5, 7)}};
+	EXPECT_EQ(plan.evaluate(m), carl::evaluate(p, m));
+
+	std::map<Variable, Interval<double>> md = {
+		{x, Interval<double>(-1.0, 2.0)},
+		{y, Interval<double>(0.5, 3.0)},
+		{z, Interval<double>(0.0, 1.0)},
+	};
+	EXPECT_EQ(plan.evaluate(md), carl::evaluate(h, md));
+}
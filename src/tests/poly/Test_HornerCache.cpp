@@ -0,0 +1,89 @@
+#include "gtest/gtest.h"
+
+#include <carl-arith/poly/umvpoly/MultivariatePolynomial.h>
+#include <carl-arith/poly/umvpoly/functions/IntervalEvaluation.h>
+#include <carl-arith/poly/umvpoly/functions/horner/HornerCache.h>
+
+#include "../Common.h"
+
+using namespace carl;
+
+class HornerCacheTest: public ::testing::Test {
+protected:
+	using Poly = MultivariatePolynomial<Rational>;
+	Variable x = fresh_real_variable("x");
+	Variable y = fresh_real_variable("y");
+	Variable z = fresh_real_variable("z");
+	// x^2*y + x^2*z + x*y*z + 3*x - 2
+	Poly p = Poly({Rational(1)*x*x*y, Rational(1)*x*x*z, Rational(1)*x*y*z, Rational(3)*x, Term<Rational>(Rational(-2))});
+};
+
+TEST_F(HornerCacheTest, Sharing)
+{
+	auto& cache = HornerCache<Poly>::getInstance();
+	cache.clear();
+	auto plan = cache.plan(p);
+	EXPECT_EQ(cache.size(), 1);
+	EXPECT_EQ(cache.plan(p), plan);
+	EXPECT_EQ(cache.plan(Poly(p)), plan);
+	EXPECT_NE(cache.plan(p + Poly(x)), plan);
+	EXPECT_EQ(cache.size(), 2);
+
+	auto entry = cache.get(p);
+	EXPECT_TRUE(entry.selection == GREEDY_I || entry.selection == GREEDY_II);
+	EXPECT_EQ(entry.cost, HornerCache<Poly>::cost(*entry.plan));
+	EXPECT_GT(entry.cost, 0);
+
+	cache.clear();
+	EXPECT_EQ(cache.size(), 0);
+	// Plans stay valid after being removed from the cache.
+	EXPECT_EQ(plan->evaluate(std::vector<Rational>({Rational(1), Rational(2), Rational(3)})), Rational(1*2 + 1*3 + 1*2*3 + 3 - 2));
+	// The selection does not depend on timings, hence building the scheme again yields the same one.
+	auto rebuilt = cache.get(p);
+	EXPECT_EQ(rebuilt.selection, entry.selection);
+	EXPECT_EQ(rebuilt.cost, entry.cost);
+	EXPECT_EQ(rebuilt.plan->instructions().size(), entry.plan->instructions().size());
+}
+
+TEST_F(HornerCacheTest, Capacity)
+{
+	auto& cache = HornerCache<Poly>::getInstance();
+	cache.clear();
+	EXPECT_EQ(cache.capacity(), HornerCache<Poly>::default_capacity);
+	cache.set_capacity(2);
+	auto plan = cache.plan(p);
+	cache.plan(p + Poly(x));
+	EXPECT_EQ(cache.size(), 2);
+	// Hits do not clear the cache.
+	EXPECT_EQ(cache.plan(p), plan);
+	EXPECT_EQ(cache.size(), 2);
+	// The cache is full, a new scheme clears it.
+	cache.plan(p + Poly(y));
+	EXPECT_EQ(cache.size(), 1);
+	EXPECT_NE(cache.plan(p), plan);
+	EXPECT_EQ(cache.size(), 2);
+	// Evicted plans stay valid.
+	EXPECT_EQ(plan->evaluate(std::vector<Rational>({Rational(1), Rational(2), Rational(3)})), Rational(1*2 + 1*3 + 1*2*3 + 3 - 2));
+	cache.set_capacity(HornerCache<Poly>::default_capacity);
+	cache.clear();
+}
+
+TEST_F(HornerCacheTest, Evaluation)
+{
+	auto plan = HornerCache<Poly>::getInstance().plan(p);
+	Interval<double>::evalintervalmap map;
+	map[x] = Interval<double>(-1, 2);
+	map[y] = Interval<double>(0, 1);
+	map[z] = Interval<double>(-3, -2);
+	Interval<double> res = plan->evaluate(map);
+	Interval<double> naive = carl::evaluate(p, map);
+	// Every horner scheme encloses the range and is at least as tight as the naive evaluation on this box.
+	for (const auto& [vx, vy, vz]: std::vector<std::tuple<double, double, double>>({{-1, 0, -3}, {2, 1, -2}, {0.5, 0.5, -2.5}, {2, 0, -3}})) {
+		double value = vx*vx*vy + vx*vx*vz + vx*vy*vz + 3*vx - 2;
+		EXPECT_TRUE(res.contains(value));
+	}
+	EXPECT_LE(res.diameter(), naive.diameter());
+
+	Poly c(Rational(5));
+	EXPECT_EQ(HornerCache<Poly>::getInstance().plan(c)->evaluate(std::vector<Rational>()), Rational(5));
+}
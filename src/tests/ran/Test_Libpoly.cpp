@@ -165,4 +165,25 @@ TEST(LIBPOLY, convertRan) {
     }
 }
 
+TEST(LIBPOLY, sortAndDedup) {
+    Variable x = fresh_real_variable("x");
+    using UPoly = carl::UnivariatePolynomial<mpq_class>;
+    UPoly p(x, {(mpq_class)-2, (mpq_class)0, (mpq_class)1});
+    UPoly q(x, {(mpq_class)-3, (mpq_class)0, (mpq_class)1});
+
+    LPRealAlgebraicNumber sqrt2(p, Interval<mpq_class>(0, BoundType::STRICT, 2, BoundType::STRICT));
+    LPRealAlgebraicNumber msqrt2(p, Interval<mpq_class>(-2, BoundType::STRICT, 0, BoundType::STRICT));
+    LPRealAlgebraicNumber sqrt3(q, Interval<mpq_class>(1, BoundType::STRICT, 2, BoundType::STRICT));
+    LPRealAlgebraicNumber sqrt2_other(p * q, Interval<mpq_class>(mpq_class(13, 10), BoundType::STRICT, mpq_class(3, 2), BoundType::STRICT));
+    LPRealAlgebraicNumber one(mpq_class(1));
+
+    std::vector<LPRealAlgebraicNumber> rans = {sqrt3, one, sqrt2, msqrt2, sqrt2_other, sqrt2, one};
+    sort_and_dedup(rans);
+    std::vector<LPRealAlgebraicNumber> expected = {msqrt2, one, sqrt2, sqrt3};
+    ASSERT_EQ(rans.size(), expected.size());
+    for (std::size_t i = 0; i < rans.size(); ++i) {
+        EXPECT_EQ(rans[i], expected[i]);
+    }
+}
+
 #endif
\ No newline at end of file
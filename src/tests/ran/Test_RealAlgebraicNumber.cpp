@@ -102,3 +102,70 @@ TEST(RealAlgebraicNumber, EvalBug2)
 
 
 
+
+TEST(RealAlgebraicNumber, RationalRepresentation)
+{
+	using RAN = IntRepRealAlgebraicNumber<Rational>;
+	Variable x = fresh_real_variable("x");
+	UnivariatePolynomial<Rational> p(x, std::initializer_list<Rational>{-2, 0, 1});
+	RAN sqrt2 = RAN::create_safe(p, Interval<Rational>(0, BoundType::STRICT, 2, BoundType::STRICT));
+	RAN half(Rational(1, 2));
+	RAN linear(UnivariatePolynomial<Rational>(x, std::initializer_list<Rational>{-3, 2}), Interval<Rational>(1, BoundType::STRICT, 2, BoundType::STRICT));
+	RAN point(p, Interval<Rational>(Rational(5, 3)));
+
+	EXPECT_TRUE(half.is_numeric());
+	EXPECT_TRUE(linear.is_numeric());
+	EXPECT_TRUE(point.is_numeric());
+	EXPECT_FALSE(sqrt2.is_numeric());
+	EXPECT_EQ(linear.value(), Rational(3, 2));
+	EXPECT_EQ(point.value(), Rational(5, 3));
+	EXPECT_TRUE(carl::is_zero(RAN()));
+	EXPECT_FALSE(carl::is_zero(half));
+	EXPECT_TRUE(carl::is_integer(RAN(Rational(4))));
+	EXPECT_FALSE(carl::is_integer(half));
+
+	EXPECT_TRUE(half < sqrt2);
+	EXPECT_TRUE(sqrt2 < linear);
+	EXPECT_TRUE(half < linear);
+	EXPECT_TRUE(half == RAN(Rational(1, 2)));
+	EXPECT_TRUE(sqrt2 > half);
+	EXPECT_TRUE(linear >= sqrt2);
+
+	EXPECT_EQ(carl::floor(half), Rational(0));
+	EXPECT_EQ(carl::ceil(half), Rational(1));
+	EXPECT_EQ(carl::abs(RAN(Rational(-1, 2))), half);
+	EXPECT_EQ(carl::sgn(RAN(Rational(-1, 2))), Sign::NEGATIVE);
+	EXPECT_EQ(carl::sgn(half, p), Sign::NEGATIVE);
+	EXPECT_EQ(carl::sgn(RAN(Rational(2)), UnivariatePolynomial<Rational>(x, std::initializer_list<Rational>{-2, 1})), Sign::ZERO);
+
+	Rational s = carl::sample_between(half, sqrt2);
+	EXPECT_TRUE(half < s && s < sqrt2);
+	s = carl::sample_between(sqrt2, linear);
+	EXPECT_TRUE(sqrt2 < s && s < linear);
+}
+
+TEST(RealAlgebraicNumber, SortAndDedup)
+{
+	using RAN = IntRepRealAlgebraicNumber<Rational>;
+	Variable x = fresh_real_variable("x");
+	UnivariatePolynomial<Rational> p(x, std::initializer_list<Rational>{-2, 0, 1});
+	UnivariatePolynomial<Rational> q(x, std::initializer_list<Rational>{-3, 0, 1});
+	// (x^2-2)*(x^2-3)
+	UnivariatePolynomial<Rational> pq = p * q;
+	RAN sqrt2 = RAN::create_safe(p, Interval<Rational>(0, BoundType::STRICT, 2, BoundType::STRICT));
+	RAN msqrt2 = RAN::create_safe(p, Interval<Rational>(-2, BoundType::STRICT, 0, BoundType::STRICT));
+	RAN sqrt3 = RAN::create_safe(q, Interval<Rational>(1, BoundType::STRICT, 2, BoundType::STRICT));
+	RAN sqrt2_other = RAN::create_safe(pq, Interval<Rational>(Rational(13, 10), BoundType::STRICT, Rational(3, 2), BoundType::STRICT));
+
+	std::vector<RAN> rans = { sqrt3, RAN(Rational(1)), sqrt2, msqrt2, sqrt2_other, RAN(Rational(3, 2)), sqrt2, RAN(Rational(1)) };
+	carl::sort_and_dedup(rans);
+	std::vector<RAN> expected = { msqrt2, RAN(Rational(1)), sqrt2, RAN(Rational(3, 2)), sqrt3 };
+	ASSERT_EQ(rans.size(), expected.size());
+	for (std::size_t i = 0; i < rans.size(); ++i) {
+		EXPECT_EQ(rans[i], expected[i]);
+	}
+
+	std::vector<RAN> empty;
+	carl::sort_and_dedup(empty);
+	EXPECT_TRUE(empty.empty());
+}
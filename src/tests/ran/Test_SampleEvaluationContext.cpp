@@ -0,0 +1,135 @@
+#include "gtest/gtest.h"
+
+#include <carl-arith/poly/umvpoly/UnivariatePolynomial.h>
+#include <carl-arith/ran/ran.h>
+#include <carl-arith/ran/interval/SampleEvaluationContext.h>
+
+#include "../Common.h"
+
+using namespace carl;
+
+using Poly = MultivariatePolynomial<Rational>;
+using UPoly = UnivariatePolynomial<Rational>;
+using RAN = IntRepRealAlgebraicNumber<Rational>;
+
+TEST(SampleEvaluationContext, Polynomials)
+{
+	Variable x = fresh_real_variable("x");
+	Variable y = fresh_real_variable("y");
+	Variable z = fresh_real_variable("z");
+	RAN sqrt2 = RAN::create_safe(UPoly(x, {-2, 0, 1}), Interval<Rational>(0, BoundType::STRICT, 2, BoundType::STRICT));
+
+	Assignment<RAN> m;
+	m.emplace(x, sqrt2);
+	m.emplace(y, Rational(3));
+	m.emplace(z, Rational(-1, 2));
+
+	ran::interval::SampleEvaluationContext<Rational> ctx(m);
+	EXPECT_EQ(ctx.rationals().size(), 2);
+	EXPECT_EQ(ctx.irrationals().size(), 1);
+
+	std::vector<Poly> polys = {
+		Poly(y) * Poly(z),
+		Poly(x) * Poly(x) - Poly(2),
+		Poly(x) * Poly(x) - Poly(y),
+		Poly(x) * Poly(y) + Poly(z),
+	};
+	for (const auto& p: polys) {
+		auto expected = carl::evaluate(p, m);
+		auto res = ctx.evaluate(p);
+		ASSERT_TRUE(expected);
+		ASSERT_TRUE(res);
+		EXPECT_EQ(*expected, *res);
+	}
+
+	auto res = ctx.evaluate(polys);
+	ASSERT_EQ(res.size(), polys.size());
+	EXPECT_EQ(*res[0], RAN(Rational(-3, 2)));
+	EXPECT_TRUE(carl::is_zero(*res[1]));
+	EXPECT_EQ(carl::sgn(*res[2]), Sign::NEGATIVE);
+	EXPECT_EQ(carl::sgn(*res[3]), Sign::POSITIVE);
+}
+
+TEST(SampleEvaluationContext, Constraints)
+{
+	Variable x = fresh_real_variable("x");
+	Variable y = fresh_real_variable("y");
+	RAN sqrt2 = RAN::create_safe(UPoly(x, {-2, 0, 1}), Interval<Rational>(0, BoundType::STRICT, 2, BoundType::STRICT));
+	RAN sqrt3 = RAN::create_safe(UPoly(y, {-3, 0, 1}), Interval<Rational>(1, BoundType::STRICT, 2, BoundType::STRICT));
+
+	Assignment<RAN> m;
+	m.emplace(x, sqrt2);
+	m.emplace(y, sqrt3);
+	ran::interval::SampleEvaluationContext<Rational> ctx(m);
+
+	std::vector<BasicConstraint<Poly>> constraints = {
+		BasicConstraint<Poly>(Poly(x) * Poly(x) - Poly(2), Relation::EQ),
+		BasicConstraint<Poly>(Poly(x) - Poly(y), Relation::LESS),
+		BasicConstraint<Poly>(Poly(x) * Poly(x) * Poly(y) * Poly(y) - Poly(6), Relation::NEQ),
+		BasicConstraint<Poly>(Poly(x) + Poly(y), Relation::LEQ),
+	};
+	std::vector<bool> expected = { true, true, false, false };
+	for (std::size_t i = 0; i < constraints.size(); ++i) {
+		EXPECT_EQ((bool)carl::evaluate(constraints[i], m), expected[i]);
+		EXPECT_EQ((bool)ctx.evaluate(constraints[i]), expected[i]);
+	}
+	auto res = ctx.evaluate(constraints, 2);
+	ASSERT_EQ(res.size(), constraints.size());
+	for (std::size_t i = 0; i < constraints.size(); ++i) {
+		EXPECT_EQ((bool)res[i], expected[i]);
+	}
+}
+
+TEST(SampleEvaluationContext, Clone)
+{
+	Variable x = fresh_real_variable("x");
+	RAN sqrt2 = RAN::create_safe(UPoly(x, {-2, 0, 1}), Interval<Rational>(0, BoundType::STRICT, 2, BoundType::STRICT));
+	Assignment<RAN> m;
+	m.emplace(x, sqrt2);
+
+	ran::interval::SampleEvaluationContext<Rational> ctx(m);
+	auto copy = ctx.clone();
+	const auto& ran = ctx.irrationals().at(x);
+	const auto& copied = copy.irrationals().at(x);
+	EXPECT_EQ(ran.interval(), copied.interval());
+	ran.refine();
+	EXPECT_NE(ran.interval(), copied.interval());
+	EXPECT_EQ(ran, copied);
+}
+
+#ifdef THREAD_SAFE
+TEST(SampleEvaluationContext, Threads)
+{
+	Variable x = fresh_real_variable("x");
+	Variable y = fresh_real_variable("y");
+	RAN sqrt2 = RAN::create_safe(UPoly(x, {-2, 0, 1}), Interval<Rational>(0, BoundType::STRICT, 2, BoundType::STRICT));
+	RAN sqrt3 = RAN::create_safe(UPoly(y, {-3, 0, 1}), Interval<Rational>(1, BoundType::STRICT, 2, BoundType::STRICT));
+	Assignment<RAN> m;
+	m.emplace(x, sqrt2);
+	m.emplace(y, sqrt3);
+	ran::interval::SampleEvaluationContext<Rational> ctx(m);
+
+	// Constraints close to zero need the root bounds and refine the private RANs of every worker.
+	std::vector<Poly> polys;
+	std::vector<BasicConstraint<Poly>> constraints;
+	for (int i = -8; i <= 8; ++i) {
+		Poly p = Poly(x) * Poly(y) - Poly(Rational(49 + i, 20));
+		polys.push_back(p);
+		constraints.emplace_back(p, Relation::GREATER);
+		constraints.emplace_back(Poly(x) * Poly(x) * Poly(y) * Poly(y) - Poly(6) + Poly(Rational(i, 1000)), Relation::EQ);
+	}
+	auto sequential = ctx.evaluate(constraints);
+	auto parallel = ctx.evaluate(constraints, 4);
+	ASSERT_EQ(sequential.size(), parallel.size());
+	for (std::size_t i = 0; i < constraints.size(); ++i) {
+		EXPECT_EQ((bool)carl::evaluate(constraints[i], m), (bool)parallel[i]) << constraints[i];
+		EXPECT_EQ((bool)sequential[i], (bool)parallel[i]) << constraints[i];
+	}
+	auto values = ctx.evaluate(polys, 4);
+	ASSERT_EQ(values.size(), polys.size());
+	for (std::size_t i = 0; i < polys.size(); ++i) {
+		ASSERT_TRUE(values[i]);
+		EXPECT_EQ(*carl::evaluate(polys[i], m), *values[i]) << polys[i];
+	}
+}
+#endif
@@ -0,0 +1,98 @@
+#include "gtest/gtest.h"
+
+#include <carl-arith/ran/thom/ThomRootFinder.h>
+
+#include "../Common.h"
+
+#include <thread>
+
+using namespace carl;
+
+using Poly = MultivariatePolynomial<Rational>;
+
+TEST(SignDeterminationCache, Reuse)
+{
+	Variable x = fresh_real_variable("x");
+	Poly p = Poly(x) * Poly(x) - Rational(2);
+	Poly q = Poly(x) * Poly(x) * Poly(x) - Poly(x);
+	auto& cache = SignDeterminationCache<Rational>::getInstance();
+
+	auto [sd, signs] = cache.get(p, x);
+	EXPECT_EQ(sd->sizeOfZeroSet(), 2);
+	EXPECT_EQ(signs.size(), 2);
+
+	// As long as the sign determination is in use, it is handed out again.
+	auto [sd2, signs2] = cache.get(p, x);
+	EXPECT_EQ(sd, sd2);
+	EXPECT_EQ(signs, signs2);
+
+	auto [sdq, signsq] = cache.get(q, x);
+	EXPECT_NE(sd, sdq);
+	EXPECT_EQ(signsq.size(), 3);
+
+	// Entries do not keep the sign determination alive.
+	std::weak_ptr<SignDetermination<Rational>> weak = sd;
+	sd.reset();
+	sd2.reset();
+	EXPECT_TRUE(weak.expired());
+	auto [sd3, signs3] = cache.get(p, x);
+	EXPECT_EQ(signs, signs3);
+}
+
+TEST(SignDeterminationCache, SharedTarskiQueries)
+{
+	Variable x = fresh_real_variable("x");
+	std::vector<Poly> zeroSet = { Poly(x) * Poly(x) - Rational(2) };
+	TarskiQueryManager<Rational> taq(zeroSet.begin(), zeroSet.end());
+	TarskiQueryManager<Rational> copy = taq;
+
+	// x is positive on one root and negative on the other.
+	EXPECT_EQ(taq(Poly(x) + Rational(1)), 0);
+	EXPECT_EQ(copy.cacheSize(), 1);
+	// Both roots are larger than -2, the result is taken from the cache by normalization.
+	EXPECT_EQ(taq(Poly(x) + Rational(2)), 2);
+	EXPECT_EQ(copy(Rational(-3) * Poly(x) - Rational(6)), -2);
+	EXPECT_EQ(taq.cacheSize(), 2);
+
+	// Copies of a sign determination share the query results as well.
+	SignDetermination<Rational> sd(zeroSet.begin(), zeroSet.end());
+	SignDetermination<Rational> sdCopy = sd;
+	EXPECT_EQ(sd.getSigns(Poly(x)).size(), 2);
+	std::size_t queries = sd.taqManager().cacheSize();
+	EXPECT_GT(queries, 0);
+	EXPECT_EQ(sdCopy.taqManager().cacheSize(), queries);
+	EXPECT_EQ(sdCopy.getSigns(Poly(x)).size(), 2);
+	EXPECT_EQ(sdCopy.taqManager().cacheSize(), queries);
+}
+
+TEST(SignDeterminationCache, RootFinder)
+{
+	Variable x = fresh_real_variable("x");
+	Poly p = Poly(x) * Poly(x) - Rational(2);
+	auto roots = realRootsThom<Rational>(p, x);
+	ASSERT_EQ(roots.size(), 2);
+	EXPECT_TRUE(roots.front() < roots.back());
+
+	// Roots found by another call use the same sign determination and are comparable.
+	auto again = realRootsThom<Rational>(p, x);
+	ASSERT_EQ(again.size(), 2);
+	EXPECT_TRUE(roots.front() == again.front());
+	EXPECT_TRUE(roots.back() == again.back());
+	EXPECT_TRUE(again.front() < roots.back());
+}
+
+TEST(SignDeterminationCache, PerThread)
+{
+	Variable x = fresh_real_variable("x");
+	Poly p = Poly(x) * Poly(x) - Rational(2);
+	auto [sd, signs] = SignDeterminationCache<Rational>::getInstance().get(p, x);
+	std::shared_ptr<SignDetermination<Rational>> other;
+	std::thread t([&]() {
+		other = SignDeterminationCache<Rational>::getInstance().get(p, x).first;
+	});
+	t.join();
+	// Another thread does not get the sign determination used by this thread.
+	EXPECT_NE(sd, other);
+	EXPECT_EQ(sd->sizeOfZeroSet(), other->sizeOfZeroSet());
+	EXPECT_EQ(sd, SignDeterminationCache<Rational>::getInstance().get(p, x).first);
+}